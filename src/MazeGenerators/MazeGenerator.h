@@ -8,6 +8,7 @@ class MazeGenerator
 {
 public:
 	MazeGenerator(Mesh* mesh) : m_mesh{ mesh } {}
+	virtual ~MazeGenerator() = default;
 	/// <summary>
 	/// Run another step of pathfinding visualisation
 	/// </summary>
@@ -8,16 +8,15 @@ RandomFillGenerator::RandomFillGenerator(Mesh* mesh) : MazeGenerator(mesh), m_ge
 ////////////////////////////////////////////////////////////
 void RandomFillGenerator::updateGenerator()
 {
-	std::vector<Cell>& cellVec = m_mesh->getSquareVec();
-	int cellNumber = static_cast<int>(cellVec.size());
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	int cellNumber = static_cast<int>(cellTypes.size());
 	if (!m_isFinished)
 	{
-		if (cellVec[m_currentIndex].cellType == SquareType::EMPTY)
+		if (cellTypes[m_currentIndex] == SquareType::EMPTY)
 		{
 			if (m_distribution(m_generator) < WALL_PROBABILITY)
 			{
-				cellVec[m_currentIndex].cellType = SquareType::FULL;
-				m_mesh->setCellColor(SquareType::FULL, m_currentIndex);
+				m_mesh->setCellType(m_currentIndex, SquareType::FULL);
 			}
 		}
 		m_currentIndex++;
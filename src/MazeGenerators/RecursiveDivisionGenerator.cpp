@@ -16,11 +16,8 @@ void RecursiveDivisionGenerator::updateGenerator()
         // Check if there are walls to draw
         if (!m_wallIndexes.empty())
         {
-            std::vector<Cell>& cellVec = m_mesh->getSquareVec();      
             // Create new wall
-            int wallIndex = m_wallIndexes.front();
-            cellVec[wallIndex].cellType = SquareType::FULL;
-            m_mesh->setCellColor(SquareType::FULL, wallIndex);
+            m_mesh->setCellType(m_wallIndexes.front(), SquareType::FULL);
             // Remove wall index
             m_wallIndexes.pop();
             return;
@@ -50,7 +47,6 @@ bool RecursiveDivisionGenerator::isFinished()
 ////////////////////////////////////////////////////////////
 void RecursiveDivisionGenerator::divideMaze(int x, int y, int sectionWidth, int sectionHeight,int orientation)
 {
-    std::vector<Cell>& cellVec = m_mesh->getSquareVec();
     sf::Vector2i mazeSize = m_mesh->getMeshSize();
 
     if (sectionWidth < 5 || sectionHeight < 5)
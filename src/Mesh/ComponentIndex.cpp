@@ -0,0 +1,143 @@
+#include "ComponentIndex.h"
+#include "Mesh.h"
+#include "src/Utility/ThreadPool.h"
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+void ComponentIndex::resize(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+	m_parents.assign(width * height, WALL);
+	m_roots.resize(width * height);
+	m_isValid = false;
+}
+
+////////////////////////////////////////////////////////////
+void ComponentIndex::build(const std::vector<SquareType>& cellTypes, int threadCount)
+{
+	int stripCount = std::clamp(threadCount, 1, std::max(1, m_height));
+	int stripHeight = (m_height + stripCount - 1) / std::max(1, stripCount);
+	// Threads are needed only during build, which happens after walls were added
+	ThreadPool threadPool(stripCount);
+	// Trees of each strip stay inside it, so strips are labelled without sharing any cell
+	threadPool.parallelFor(stripCount, 1, [&](int, int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				labelStrip(cellTypes, i * stripHeight, std::min((i + 1) * stripHeight, m_height));
+			}
+		});
+	for (int row = stripHeight; row < m_height; row += stripHeight)
+	{
+		for (int column = 0; column < m_width; ++column)
+		{
+			int index = row * m_width + column;
+			if (cellTypes[index] == SquareType::FULL)
+			{
+				continue;
+			}
+			for (int aboveColumn = std::max(column - 1, 0); aboveColumn <= std::min(column + 1, m_width - 1); ++aboveColumn)
+			{
+				int aboveIndex = index - m_width + aboveColumn - column;
+				if (cellTypes[aboveIndex] != SquareType::FULL)
+				{
+					joinCells(index, aboveIndex);
+				}
+			}
+		}
+	}
+	// Flatten forest so later queries are one lookup; roots are read first and written in separate pass
+	int cellCount = m_width * m_height;
+	int chunkSize = std::max(1, cellCount / (stripCount * 4));
+	threadPool.parallelFor(cellCount, chunkSize, [this](int, int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				int root = m_parents[i];
+				if (root != WALL)
+				{
+					while (m_parents[root] != root)
+					{
+						root = m_parents[root];
+					}
+				}
+				m_roots[i] = root;
+			}
+		});
+	m_parents.swap(m_roots);
+	m_isValid = true;
+}
+
+////////////////////////////////////////////////////////////
+void ComponentIndex::openCell(int index)
+{
+	m_parents[index] = index;
+}
+
+////////////////////////////////////////////////////////////
+void ComponentIndex::joinCells(int first, int second)
+{
+	int firstRoot = findRoot(first);
+	int secondRoot = findRoot(second);
+	// Lower index becomes root, so labels do not depend on order of joins
+	if (firstRoot < secondRoot)
+	{
+		m_parents[secondRoot] = firstRoot;
+	}
+	else if (secondRoot < firstRoot)
+	{
+		m_parents[firstRoot] = secondRoot;
+	}
+}
+
+////////////////////////////////////////////////////////////
+int ComponentIndex::getComponent(int index)
+{
+	return m_parents[index] == WALL ? WALL : findRoot(index);
+}
+
+////////////////////////////////////////////////////////////
+int ComponentIndex::findRoot(int index)
+{
+	while (m_parents[index] != index)
+	{
+		m_parents[index] = m_parents[m_parents[index]];
+		index = m_parents[index];
+	}
+	return index;
+}
+
+////////////////////////////////////////////////////////////
+void ComponentIndex::labelStrip(const std::vector<SquareType>& cellTypes, int firstRow, int lastRow)
+{
+	for (int row = firstRow; row < lastRow; ++row)
+	{
+		for (int column = 0; column < m_width; ++column)
+		{
+			int index = row * m_width + column;
+			if (cellTypes[index] == SquareType::FULL)
+			{
+				m_parents[index] = WALL;
+				continue;
+			}
+			m_parents[index] = index;
+			// Left neighbour and three neighbours above were already labelled
+			if (column > 0 && cellTypes[index - 1] != SquareType::FULL)
+			{
+				joinCells(index, index - 1);
+			}
+			if (row > firstRow)
+			{
+				for (int aboveColumn = std::max(column - 1, 0); aboveColumn <= std::min(column + 1, m_width - 1); ++aboveColumn)
+				{
+					int aboveIndex = index - m_width + aboveColumn - column;
+					if (cellTypes[aboveIndex] != SquareType::FULL)
+					{
+						joinCells(index, aboveIndex);
+					}
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+enum class SquareType : std::uint8_t;
+
+/// <summary>
+/// Labels of 8-connected regions of open (non-wall) cells, kept as union-find forest over cell indexes.
+/// Built in parallel: horizontal strips are labelled independently, then labels are joined across strip borders.
+/// Opening a cell joins it with its neighbours in place, closing a cell may split region, so it only marks index outdated.
+/// </summary>
+class ComponentIndex
+{
+public:
+	/// <summary>
+	/// Allocate index for mesh of given size (index starts outdated)
+	/// </summary>
+	/// <param name="width">Number of cells in row</param>
+	/// <param name="height">Number of cells in column</param>
+	void resize(int width, int height);
+	/// <summary>
+	/// Mark index outdated, so it is rebuilt before next query
+	/// </summary>
+	void invalidate() { m_isValid = false; }
+	/// <summary>
+	/// Check if index matches terrain
+	/// </summary>
+	/// <returns>True if index is up to date</returns>
+	bool isValid() const { return m_isValid; }
+	/// <summary>
+	/// Label all regions from scratch
+	/// </summary>
+	/// <param name="cellTypes">Terrain plane of mesh</param>
+	/// <param name="threadCount">Number of threads labelling strips</param>
+	void build(const std::vector<SquareType>& cellTypes, int threadCount = static_cast<int>(std::thread::hardware_concurrency()));
+	/// <summary>
+	/// Add opened cell as region of its own (join it with its open neighbours afterwards)
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	void openCell(int index);
+	/// <summary>
+	/// Merge regions of two open cells
+	/// </summary>
+	/// <param name="first">Index of first cell</param>
+	/// <param name="second">Index of second cell</param>
+	void joinCells(int first, int second);
+	/// <summary>
+	/// Get region of cell
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Lowest index of region cells (-1 for wall)</returns>
+	int getComponent(int index);
+private:
+	/// <summary>
+	/// Find root of cell's tree, halving path on the way
+	/// </summary>
+	/// <param name="index">Index of open cell</param>
+	/// <returns>Index of root</returns>
+	int findRoot(int index);
+	/// <summary>
+	/// Label rows [firstRow, lastRow) considering only cells inside them
+	/// </summary>
+	/// <param name="cellTypes">Terrain plane of mesh</param>
+	/// <param name="firstRow">First row of strip</param>
+	/// <param name="lastRow">Row after last row of strip</param>
+	void labelStrip(const std::vector<SquareType>& cellTypes, int firstRow, int lastRow);
+private:
+	static constexpr int WALL = -1;		//!< Parent of wall cell
+	int m_width{};						//!< Number of cells in row
+	int m_height{};						//!< Number of cells in column
+	std::vector<int> m_parents;			//!< Parent of each cell in union-find forest (roots point to themselves)
+	std::vector<int> m_roots;			//!< Roots found while flattening forest after build
+	bool m_isValid{ false };			//!< Does index match terrain
+};
\ No newline at end of file
@@ -1,15 +1,94 @@
 #include "GridManager.h"
-#include <iostream>
+#include <algorithm>
 #include <random>
 #include "src/Solvers/DFSSolver.h"
 #include "src/Solvers/BFSSolver.h"
 #include "src/Solvers/DjikstraSolver.h"
 #include "src/Solvers/AStarSolver.h"
+#include "src/Solvers/DialSolver.h"
+#include "src/Solvers/JPSSolver.h"
+#include "src/Solvers/BidirectionalSolver.h"
+#include "src/Solvers/ParallelBFSSolver.h"
+#include "src/Solvers/DeltaSteppingSolver.h"
+#include "src/Solvers/BitBFSSolver.h"
+#include "src/Solvers/HPAStarSolver.h"
+#include "src/Solvers/DStarLiteSolver.h"
+#include "src/Solvers/DistanceFieldSolver.h"
+#include "src/Solvers/IDAStarSolver.h"
+#include "src/Solvers/FringeSearchSolver.h"
 #include "src/MazeGenerators/RandomFillGenerator.h"
 #include "src/MazeGenerators/RecursiveDivisionGenerator.h"
+#include "src/Utility/Timer.h"
+
+/// <summary>
+/// Create solver instantiated for connectivity policy matching runtime choice
+/// </summary>
+/// <typeparam name="Solver">Solver template taking connectivity policy</typeparam>
+/// <param name="moveSet">Moves allowed between cells</param>
+/// <param name="mesh">Mesh to operate on</param>
+/// <returns>Solver</returns>
+template<template<typename> class Solver>
+std::unique_ptr<MeshSolver> createConnectivitySolver(MoveSet moveSet, Mesh* mesh)
+{
+	switch (moveSet)
+	{
+	case MoveSet::FOUR:
+		return std::make_unique<Solver<FourConnectivity>>(mesh);
+	case MoveSet::EIGHT_NO_CORNER_CUTTING:
+		return std::make_unique<Solver<NoCornerCuttingConnectivity>>(mesh);
+	default:
+		return std::make_unique<Solver<EightConnectivity>>(mesh);
+	}
+}
+
+/// <summary>
+/// Create solver instantiated for cost policy matching runtime choice
+/// </summary>
+/// <typeparam name="Solver">Solver template taking connectivity and cost policies</typeparam>
+/// <typeparam name="Connectivity">Connectivity policy</typeparam>
+/// <param name="moveCost">Cost of moves</param>
+/// <param name="mesh">Mesh to operate on</param>
+/// <param name="args">Remaining constructor arguments</param>
+/// <returns>Solver</returns>
+template<template<typename, typename> class Solver, typename Connectivity, typename... Args>
+std::unique_ptr<MeshSolver> createCostSolver(MoveCost moveCost, Mesh* mesh, Args... args)
+{
+	switch (moveCost)
+	{
+	case MoveCost::UNIT:
+		return std::make_unique<Solver<Connectivity, UnitCost>>(mesh, args...);
+	case MoveCost::OCTILE:
+		return std::make_unique<Solver<Connectivity, OctileCost>>(mesh, args...);
+	default:
+		return std::make_unique<Solver<Connectivity, WeightCost>>(mesh, args...);
+	}
+}
+
+/// <summary>
+/// Create solver instantiated for connectivity and cost policies matching runtime choice
+/// </summary>
+/// <typeparam name="Solver">Solver template taking connectivity and cost policies</typeparam>
+/// <param name="moveSet">Moves allowed between cells</param>
+/// <param name="moveCost">Cost of moves</param>
+/// <param name="mesh">Mesh to operate on</param>
+/// <param name="args">Remaining constructor arguments</param>
+/// <returns>Solver</returns>
+template<template<typename, typename> class Solver, typename... Args>
+std::unique_ptr<MeshSolver> createPolicySolver(MoveSet moveSet, MoveCost moveCost, Mesh* mesh, Args... args)
+{
+	switch (moveSet)
+	{
+	case MoveSet::FOUR:
+		return createCostSolver<Solver, FourConnectivity>(moveCost, mesh, args...);
+	case MoveSet::EIGHT_NO_CORNER_CUTTING:
+		return createCostSolver<Solver, NoCornerCuttingConnectivity>(moveCost, mesh, args...);
+	default:
+		return createCostSolver<Solver, EightConnectivity>(moveCost, mesh, args...);
+	}
+}
 
 ////////////////////////////////////////////////////////////
-GridManager::GridManager()
+GridManager::GridManager() : m_scheduler(static_cast<int>(std::thread::hardware_concurrency()))
 {
 	if (!m_font.loadFromFile("Resources/arial.ttf"))
 	{
@@ -18,45 +97,136 @@ GridManager::GridManager()
 	}
 }
 
+////////////////////////////////////////////////////////////
+GridManager::~GridManager()
+{
+	stopSimulation();
+}
+
+////////////////////////////////////////////////////////////
+void GridManager::startSimulation()
+{
+	if (m_simulationThread.joinable())
+	{
+		return;
+	}
+	// First frame already has something to show
+	publishSnapshot();
+	m_simulationThread = std::thread(&GridManager::runSimulation, this);
+}
+
+////////////////////////////////////////////////////////////
+void GridManager::stopSimulation()
+{
+	if (!m_simulationThread.joinable())
+	{
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_commandMutex);
+		m_isStopping = true;
+	}
+	m_commandCondition.notify_one();
+	m_simulationThread.join();
+	m_isStopping = false;
+}
+
 ////////////////////////////////////////////////////////////
 void GridManager::draw(sf::RenderTarget& target, sf::FloatRect& windowBound)
 {
+	const GridSnapshot& snapshot = m_snapshots.getReadBuffer();
+	if (snapshot.meshes.size() != m_meshVec.size())
+	{
+		// Nothing was published yet
+		return;
+	}
 	int index{};
 	for (auto it = m_meshVec.begin(); it != m_meshVec.end(); ++it)
 	{
 		if (it->isVisible(windowBound))
 		{
-			it->draw(target, m_font, drawSquares, drawLines, drawWeights);
+			it->draw(target, m_font, snapshot.meshes[index], drawSquares, drawLines, drawWeights);
 		}
 		if (it != std::prev(m_meshVec.end()))
 		{
-			std::string solverName = m_solvers[index]->getSolverName();
-			int processedCells = m_solvers[index]->getProcessedSquares();
-			int pathLength = m_solvers[index]->getPathLength();
-			int pathWeight = m_solvers[index]->getPathWeight();
-			it->drawData(target, m_font, solverName, processedCells, pathLength, pathWeight);
+			const PanelSnapshot& panel = snapshot.panels[index];
+			it->drawData(target, m_font, panel.solverName, panel.processedSquares, panel.pathLength, panel.pathWeight, panel.stepTime);
+		}
+		else
+		{
+			it->drawCaption(target, m_font, snapshot.clockState);
 		}
 		index++;
 	}
 }
 
 ////////////////////////////////////////////////////////////
-void GridManager::addMesh(sf::Vector2f position, sf::Vector2i meshSize, unsigned cellSize, SolverType solverType)
+void GridManager::addMesh(sf::Vector2f position, sf::Vector2i meshSize, unsigned cellSize, SolverType solverType, MoveSet moveSet, MoveCost moveCost)
 {
 	m_meshVec.emplace_back(position, meshSize, cellSize);
+	m_meshVec.back().setThreadCount(PANEL_THREAD_COUNT);
 	switch (solverType)
 	{
 	case SolverType::DFS:
-		m_solvers.emplace_back(std::make_unique<DFSSolver>(&m_meshVec.back()));
+		m_solvers.emplace_back(createConnectivitySolver<DFSSolver>(moveSet, &m_meshVec.back()));
 		break;
 	case SolverType::BFS:
-		m_solvers.emplace_back(std::make_unique<BFSSolver>(&m_meshVec.back()));
+		m_solvers.emplace_back(createConnectivitySolver<BFSSolver>(moveSet, &m_meshVec.back()));
 		break;
 	case SolverType::DJIKSTRA:
-		m_solvers.emplace_back(std::make_unique<DjikstraSolver>(&m_meshVec.back()));
+		m_solvers.emplace_back(createPolicySolver<DjikstraSolver>(moveSet, moveCost, &m_meshVec.back()));
 		break;
 	case SolverType::ASTAR:
-		m_solvers.emplace_back(std::make_unique<AStarSolver>(&m_meshVec.back()));
+		m_solvers.emplace_back(createPolicySolver<AStarSolver>(moveSet, moveCost, &m_meshVec.back()));
+		break;
+	case SolverType::DIAL:
+		m_solvers.emplace_back(std::make_unique<DialSolver>(&m_meshVec.back()));
+		break;
+	case SolverType::JPS:
+		m_solvers.emplace_back(std::make_unique<JPSSolver>(&m_meshVec.back()));
+		break;
+	case SolverType::BIDIRECTIONAL_BFS:
+		m_solvers.emplace_back(std::make_unique<BidirectionalSolver>(&m_meshVec.back(), BidirectionalMode::BFS));
+		break;
+	case SolverType::BIDIRECTIONAL_DJIKSTRA:
+		m_solvers.emplace_back(std::make_unique<BidirectionalSolver>(&m_meshVec.back(), BidirectionalMode::DJIKSTRA));
+		break;
+	case SolverType::BIDIRECTIONAL_ASTAR:
+		m_solvers.emplace_back(std::make_unique<BidirectionalSolver>(&m_meshVec.back(), BidirectionalMode::ASTAR));
+		break;
+	case SolverType::PARALLEL_BFS:
+		m_solvers.emplace_back(std::make_unique<ParallelBFSSolver>(&m_meshVec.back(), PANEL_THREAD_COUNT));
+		break;
+	case SolverType::DELTA_STEPPING:
+		m_solvers.emplace_back(std::make_unique<DeltaSteppingSolver>(&m_meshVec.back(), DeltaSteppingSolver::DEFAULT_DELTA, PANEL_THREAD_COUNT));
+		break;
+	case SolverType::BIT_BFS:
+		m_solvers.emplace_back(std::make_unique<BitBFSSolver>(&m_meshVec.back()));
+		break;
+	case SolverType::HPA_STAR:
+		m_solvers.emplace_back(std::make_unique<HPAStarSolver>(&m_meshVec.back(), HPAStarSolver::DEFAULT_CLUSTER_SIZE, PANEL_THREAD_COUNT));
+		break;
+	case SolverType::ASTAR_LANDMARKS:
+		// Landmark tables measure cell weights, so only cost policy is fixed
+		m_solvers.emplace_back(createPolicySolver<AStarSolver>(moveSet, MoveCost::CELL_WEIGHT, &m_meshVec.back(), HeapMode::DECREASE_KEY, AStarHeuristic::LANDMARKS, 1.0f, PANEL_THREAD_COUNT));
+		break;
+	case SolverType::DSTAR_LITE:
+		m_solvers.emplace_back(std::make_unique<DStarLiteSolver>(&m_meshVec.back()));
+		break;
+	case SolverType::DISTANCE_FIELD:
+		m_solvers.emplace_back(std::make_unique<DistanceFieldSolver>(&m_meshVec.back()));
+		break;
+	case SolverType::ASTAR_OCTILE:
+		m_solvers.emplace_back(createPolicySolver<AStarSolver>(moveSet, moveCost, &m_meshVec.back(), HeapMode::DECREASE_KEY, AStarHeuristic::OCTILE));
+		break;
+	case SolverType::WEIGHTED_ASTAR:
+		m_solvers.emplace_back(createPolicySolver<AStarSolver>(moveSet, moveCost, &m_meshVec.back(), HeapMode::DECREASE_KEY, AStarHeuristic::OCTILE, AStarSolver<>::WEIGHTED_HEURISTIC_WEIGHT));
+		break;
+	case SolverType::IDA_STAR:
+		m_solvers.emplace_back(std::make_unique<IDAStarSolver>(&m_meshVec.back()));
+		break;
+	case SolverType::FRINGE_SEARCH:
+		m_solvers.emplace_back(std::make_unique<FringeSearchSolver>(&m_meshVec.back()));
 		break;
 	}
 }
@@ -65,108 +235,198 @@ void GridManager::addMesh(sf::Vector2f position, sf::Vector2i meshSize, unsigned
 void GridManager::addMesh(sf::Vector2f position, sf::Vector2i meshSize, unsigned cellSize)
 {
 	m_meshVec.emplace_back(position, meshSize, cellSize);
+	m_meshVec.back().setThreadCount(PANEL_THREAD_COUNT);
 }
 
 ////////////////////////////////////////////////////////////
 void GridManager::setSquareType(sf::Vector2f mousePos, SquareType squareType)
 {
-	int index{};
-
-	for (auto it = m_meshVec.begin(); it != m_meshVec.end(); ++it)
-	{
-		if (it->isInRange(mousePos))
+	postCommand([this, mousePos, squareType]
 		{
-			it->setCellType(mousePos, squareType);
-			if (it != std::prev(m_meshVec.end()))
+			int index{};
+
+			for (auto it = m_meshVec.begin(); it != m_meshVec.end(); ++it)
 			{
-				if (squareType == SquareType::START || squareType == SquareType::FINISH)
+				if (it->isInRange(mousePos))
 				{
-					m_solvers[index]->resetStartPosition();
+					it->setCellType(mousePos, squareType);
+					if (it != std::prev(m_meshVec.end()))
+					{
+						if (squareType == SquareType::START || squareType == SquareType::FINISH)
+						{
+							m_solvers[index]->resetStartPosition();
+						}
+						clearMesh(index);
+					}
+					return;
 				}
-				clearMesh(index);
+				index++;
 			}
-			return;
-		}
-		index++;
-	}
+		});
 }
 
 ////////////////////////////////////////////////////////////
 void GridManager::changeSquareWeight(sf::Vector2f mousePos, bool isPositive)
 {
-	int index{};
-	for (auto it = m_meshVec.begin(); it != m_meshVec.end(); ++it)
-	{
-		if (it->isInRange(mousePos))
+	postCommand([this, mousePos, isPositive]
 		{
-			if (isPositive)
+			int index{};
+			for (auto it = m_meshVec.begin(); it != m_meshVec.end(); ++it)
 			{
-				it->addCellWeight(mousePos);
-			}
-			else
-			{
-				it->subCellWeight(mousePos);
+				if (it->isInRange(mousePos))
+				{
+					if (isPositive)
+					{
+						it->addCellWeight(mousePos);
+					}
+					else
+					{
+						it->subCellWeight(mousePos);
+					}
+					if (it != std::prev(m_meshVec.end()))
+					{
+						clearMesh(index);
+					}
+					return;
+				}
+				index++;
 			}
-			if (it != std::prev(m_meshVec.end()))
+		});
+}
+
+////////////////////////////////////////////////////////////
+void GridManager::copyTemplateMesh()
+{
+	postCommand([this]
+		{
+			Mesh& mesh = m_meshVec.back();
+			int index{};
+			for (auto it = m_meshVec.begin(); it != std::prev(m_meshVec.end()); ++it)
 			{
+				it->copyMesh(mesh);
+				m_solvers[index]->resetStartPosition();
 				clearMesh(index);
+				// Re-copied unchanged template needs no search
+				if (const SolveResult* result = m_pathCache.find(*m_solvers[index]))
+				{
+					m_solvers[index]->showResult(*result);
+				}
+				index++;
 			}
-			return;
-		}
-		index++;
-	}
+		});
 }
 
 ////////////////////////////////////////////////////////////
-void GridManager::copyTemplateMesh()
+void GridManager::setPaused(bool isPaused)
 {
-	Mesh& mesh = m_meshVec.back();
-	int index{};
-	for (auto it = m_meshVec.begin(); it != std::prev(m_meshVec.end()); ++it)
-	{
-		it->copyMesh(mesh);
-		clearMesh(index);
-		m_solvers[index]->resetStartPosition();
-		index++;
-	}
+	postCommand([this, isPaused]
+		{
+			m_isPaused = isPaused;
+			// Time spent paused is not caught up
+			m_simulationClock.restart();
+		});
 }
 
 ////////////////////////////////////////////////////////////
-void GridManager::update()
+void GridManager::speedUp()
 {
-	if (m_mazeGenerator)
+	postCommand([this]
+		{
+			m_simulationClock.speedUp();
+		});
+}
+
+////////////////////////////////////////////////////////////
+void GridManager::slowDown()
+{
+	postCommand([this]
+		{
+			m_simulationClock.slowDown();
+		});
+}
+
+////////////////////////////////////////////////////////////
+void GridManager::switchClockMode()
+{
+	postCommand([this]
+		{
+			m_simulationClock.switchMode();
+		});
+}
+
+////////////////////////////////////////////////////////////
+int GridManager::update(int stepCount)
+{
+	if (stepCount <= 0)
 	{
-		m_mazeGenerator->updateGenerator();
+		return 0;
 	}
+	// Every solver and generator works only on its own mesh, so steps can run in any order
+	m_stepCounts.assign(m_solvers.size() + 1, 0);
+	int index{};
 	for (auto& solver : m_solvers)
 	{
-		solver->update();
+		MeshSolver* meshSolver = solver.get();
+		int* stepsRun = &m_stepCounts[index];
+		m_scheduler.submit(index++, [meshSolver, stepCount, stepsRun]
+			{
+				for (; *stepsRun < stepCount && !meshSolver->isFinished(); ++*stepsRun)
+				{
+					meshSolver->update();
+				}
+			});
 	}
+	if (m_mazeGenerator)
+	{
+		MazeGenerator* mazeGenerator = m_mazeGenerator.get();
+		int* stepsRun = &m_stepCounts[index];
+		m_scheduler.submit(index, [mazeGenerator, stepCount, stepsRun]
+			{
+				for (; *stepsRun < stepCount && !mazeGenerator->isFinished(); ++*stepsRun)
+				{
+					mazeGenerator->updateGenerator();
+				}
+			});
+	}
+	// Meshes must not change while they are drawn
+	m_scheduler.wait();
+	for (int i = 0; i < static_cast<int>(m_solvers.size()); ++i)
+	{
+		// Search finished in this update
+		if (m_stepCounts[i] > 0 && m_solvers[i]->isFinished())
+		{
+			m_pathCache.insert(*m_solvers[i], m_solvers[i]->getResult());
+		}
+	}
+	return *std::max_element(m_stepCounts.begin(), m_stepCounts.end());
 }
 
 ////////////////////////////////////////////////////////////
 void GridManager::generateMaze()
 {
-	// Generate random maze generator
-	std::random_device rd;
-	std::mt19937 rng(rd());
-	const int MIN_RANGE = 0;
-	const int MAX_RANGE = 1;
-	std::uniform_int_distribution<int> uni(MIN_RANGE, MAX_RANGE);
+	postCommand([this]
+		{
+			// Generate random maze generator
+			std::random_device rd;
+			std::mt19937 rng(rd());
+			const int MIN_RANGE = 0;
+			const int MAX_RANGE = 1;
+			std::uniform_int_distribution<int> uni(MIN_RANGE, MAX_RANGE);
 
-	// Reset mesh to its inital state
-	m_meshVec.back().clearMesh();
-	// Pick random maze generator
-	int mazeIndex = uni(rng);
-	switch (mazeIndex)
-	{
-	case 0:
-		m_mazeGenerator = std::make_unique<RandomFillGenerator>(&m_meshVec.back());
-		break;
-	case 1:
-		m_mazeGenerator = std::make_unique< RecursiveDivisionGenerator>(&m_meshVec.back());
-		break;
-	}
+			// Reset mesh to its inital state
+			m_meshVec.back().clearMesh();
+			// Pick random maze generator
+			int mazeIndex = uni(rng);
+			switch (mazeIndex)
+			{
+			case 0:
+				m_mazeGenerator = std::make_unique<RandomFillGenerator>(&m_meshVec.back());
+				break;
+			case 1:
+				m_mazeGenerator = std::make_unique< RecursiveDivisionGenerator>(&m_meshVec.back());
+				break;
+			}
+		});
 }
 
 ////////////////////////////////////////////////////////////
@@ -180,3 +440,112 @@ void GridManager::clearMesh(int index)
 		m_solvers[index]->reset();
 	}
 }
+
+////////////////////////////////////////////////////////////
+void GridManager::postCommand(std::function<void()> command)
+{
+	if (!m_simulationThread.joinable())
+	{
+		command();
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_commandMutex);
+		m_commands.push_back(std::move(command));
+	}
+	m_commandCondition.notify_one();
+}
+
+////////////////////////////////////////////////////////////
+bool GridManager::runCommands()
+{
+	std::vector<std::function<void()>> commands;
+	bool isStopping;
+	{
+		std::lock_guard<std::mutex> lock(m_commandMutex);
+		commands.swap(m_commands);
+		isStopping = m_isStopping;
+	}
+	for (auto& command : commands)
+	{
+		command();
+	}
+	return !isStopping;
+}
+
+////////////////////////////////////////////////////////////
+void GridManager::runSimulation()
+{
+	while (runCommands())
+	{
+		if (!m_isPaused)
+		{
+			int stepCount = m_simulationClock.getStepCount();
+			Timer t;
+			t.start();
+			int stepsRun = update(stepCount);
+			t.stop();
+			m_simulationClock.reportStepTime(stepsRun, t.measure());
+		}
+		publishSnapshot();
+		std::unique_lock<std::mutex> lock(m_commandMutex);
+		auto isWoken = [this] { return !m_commands.empty() || m_isStopping; };
+		if (m_isPaused)
+		{
+			// Nothing changes until next command
+			m_commandCondition.wait(lock, isWoken);
+		}
+		else
+		{
+			m_commandCondition.wait_for(lock, SIMULATION_TICK, isWoken);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void GridManager::publishSnapshot()
+{
+	GridSnapshot& snapshot = m_snapshots.getWriteBuffer();
+	snapshot.meshes.resize(m_meshVec.size());
+	int index{};
+	for (const Mesh& mesh : m_meshVec)
+	{
+		mesh.takeSnapshot(snapshot.meshes[index++]);
+	}
+	snapshot.panels.resize(m_solvers.size());
+	const std::vector<TaskTiming>& timings = m_scheduler.getTimings();
+	auto timing = timings.begin();
+	for (int i = 0; i < static_cast<int>(m_solvers.size()); ++i)
+	{
+		PanelSnapshot& panel = snapshot.panels[i];
+		// Solver of panel never changes
+		if (panel.solverName.empty())
+		{
+			panel.solverName = m_solvers[i]->getSolverName();
+		}
+		panel.processedSquares = m_solvers[i]->getProcessedSquares();
+		panel.pathLength = m_solvers[i]->getPathLength();
+		panel.pathWeight = m_solvers[i]->getPathWeight();
+		panel.stepTime = 0.0f;
+		while (timing != timings.end() && timing->id < i)
+		{
+			++timing;
+		}
+		if (timing != timings.end() && timing->id == i)
+		{
+			panel.stepTime = timing->microseconds;
+		}
+	}
+	snapshot.clockState = getClockState();
+	m_snapshots.publish();
+}
+
+////////////////////////////////////////////////////////////
+std::string GridManager::getClockState() const
+{
+	if (m_simulationClock.getMode() == ClockMode::FIXED_RATE)
+	{
+		return "Simulation speed: " + std::to_string(static_cast<int>(m_simulationClock.getStepsPerSecond())) + " steps per second";
+	}
+	return "Simulation budget: " + std::to_string(static_cast<int>(m_simulationClock.getBudgetMicroseconds())) + " us per tick";
+}
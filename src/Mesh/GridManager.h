@@ -1,20 +1,71 @@
 #pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include "Mesh.h"
 #include "src/Solvers/MeshSolver.h"
+#include "src/Solvers/PathCache.h"
+#include "src/Solvers/SearchPolicies.h"
 #include "src/MazeGenerators/MazeGenerator.h"
+#include "src/Utility/SimulationClock.h"
+#include "src/Utility/TaskScheduler.h"
+#include "src/Utility/TripleBuffer.h"
+
+/// <summary>
+/// Results of solver shown above its mesh
+/// </summary>
+struct PanelSnapshot
+{
+	std::string solverName;		//!< Name of solver
+	int processedSquares{};		//!< Number of processed cells
+	int pathLength{};			//!< Number of cells of path
+	int pathWeight{};			//!< Weight of path
+	float stepTime{};			//!< Time of last update of solver in microseconds
+};
+
+/// <summary>
+/// State of all meshes published by simulation thread for one frame
+/// </summary>
+struct GridSnapshot
+{
+	std::vector<MeshSnapshot> meshes;	//!< Snapshots of meshes, in order of meshes
+	std::vector<PanelSnapshot> panels;	//!< Results of solvers, in order of solvers
+	std::string clockState;				//!< Mode and speed of simulation clock
+};
 
 /// <summary>
 /// The GridManager class manages a collection of Mesh objects and provides methods for drawing and adding meshes,
 /// as well as toggling the display of squares and lines and handling mouse clicks.
+/// Once simulation is started, solvers, generator and all edits of meshes run on simulation thread: edit methods only queue commands,
+/// which are run between steps. Every tick of simulation publishes snapshot of meshes through triple buffer,
+/// and draw shows latest snapshot taken by acquireSnapshot, so neither thread waits for the other.
 /// </summary>
 class GridManager
 {
 public:
 	GridManager();
 	/// <summary>
-	/// Draws all meshes within the specified window bounds to the specified render target.
+	/// Stops simulation thread
+	/// </summary>
+	~GridManager();
+	/// <summary>
+	/// Start simulation thread (meshes must not be added afterwards)
+	/// </summary>
+	void startSimulation();
+	/// <summary>
+	/// Stop and join simulation thread, queued commands are run first
+	/// </summary>
+	void stopSimulation();
+	/// <summary>
+	/// Take latest snapshot published by simulation, if there is a newer one (render thread)
+	/// </summary>
+	void acquireSnapshot() { m_snapshots.acquire(); }
+	/// <summary>
+	/// Draws all meshes within the specified window bounds to the specified render target, as captured in latest acquired snapshot.
 	/// </summary>
 	/// <param name="target">The render target to draw to.</param>
 	/// <param name="windowBound">The current camera view.</param>
@@ -26,7 +77,9 @@ public:
 	/// <param name="meshSize">The size of the Mesh object.</param>
 	/// <param name="cellSize">The size of each cell in the Mesh object.</param>
 	/// <param name="solverType">Type of solver used for this mesh</param>
-	void addMesh(sf::Vector2f position, sf::Vector2i meshSize, unsigned cellSize,SolverType solverType);
+	/// <param name="moveSet">Moves allowed by DFS, BFS, Djikstra and A* solvers</param>
+	/// <param name="moveCost">Cost of moves used by Djikstra and A* solvers</param>
+	void addMesh(sf::Vector2f position, sf::Vector2i meshSize, unsigned cellSize,SolverType solverType, MoveSet moveSet = MoveSet::EIGHT, MoveCost moveCost = MoveCost::CELL_WEIGHT);
 	/// <summary>
 	/// Adds a new Mesh object with the specified position, mesh size, and cell size to the Mesh vector.
 	/// </summary>
@@ -63,9 +116,33 @@ public:
 	/// </summary>
 	void copyTemplateMesh();
 	/// <summary>
-	/// Update solvers
+	/// Stop or resume stepping of solvers and generator
+	/// </summary>
+	/// <param name="isPaused">Should stepping stop</param>
+	void setPaused(bool isPaused);
+	/// <summary>
+	/// Raise steps per second or time budget of simulation clock
 	/// </summary>
-	void update();
+	void speedUp();
+	/// <summary>
+	/// Lower steps per second or time budget of simulation clock
+	/// </summary>
+	void slowDown();
+	/// <summary>
+	/// Switch simulation clock between fixed rate and time budget mode
+	/// </summary>
+	void switchClockMode();
+	/// <summary>
+	/// Step all solvers and maze generator as parallel tasks, returns when every step finished (simulation thread)
+	/// </summary>
+	/// <param name="stepCount">Number of steps run by every solver and generator</param>
+	/// <returns>Largest number of steps actually run (finished solvers and generator stop early)</returns>
+	int update(int stepCount = 1);
+	/// <summary>
+	/// Get times of steps run by last update (task id is index of mesh, generator has index of template mesh, simulation thread)
+	/// </summary>
+	/// <returns>Timings ordered by index of mesh</returns>
+	const std::vector<TaskTiming>& getTaskTimings() const { return m_scheduler.getTimings(); }
 	/// <summary>
 	/// Generate maze on scratch maze
 	/// </summary>
@@ -76,6 +153,32 @@ private:
 	/// </summary>
 	/// <param name="index">Index of mesh</param>
 	void clearMesh(int index);
+	/// <summary>
+	/// Run command on simulation thread, or right away if simulation is not running
+	/// </summary>
+	/// <param name="command">Edit of meshes, solvers or clock</param>
+	void postCommand(std::function<void()> command);
+	/// <summary>
+	/// Run commands queued since last call
+	/// </summary>
+	/// <returns>False if simulation should stop</returns>
+	bool runCommands();
+	/// <summary>
+	/// Loop of simulation thread: run commands, step solvers as decided by clock and publish snapshot
+	/// </summary>
+	void runSimulation();
+	/// <summary>
+	/// Copy state of meshes and solvers to write buffer and publish it
+	/// </summary>
+	void publishSnapshot();
+	/// <summary>
+	/// Describe mode and speed of simulation clock
+	/// </summary>
+	/// <returns>Text shown above template mesh</returns>
+	std::string getClockState() const;
+public:
+	static constexpr std::chrono::milliseconds SIMULATION_TICK{ 1 };	//!< Pause between ticks of running simulation, lets commands in
+	static constexpr int PANEL_THREAD_COUNT = 1;	//!< Threads of pools inside each panel (scheduler already runs panels on all hardware threads)
 private:
 	std::list<Mesh> m_meshVec;							//!< The vector of Mesh objects managed by the GridManager.
 	std::vector<std::unique_ptr<MeshSolver>> m_solvers; //!< The vector of mesh solvers (pathfinders)
@@ -84,4 +187,15 @@ private:
 	bool drawLines{ true };								//!< A flag indicating whether to draw lines or not.
 	bool drawWeights{ true };							//!< A flag indicating whether to draw cell weights or not
 	sf::Font m_font;									//!< Font for drawing cells weights
+	TaskScheduler m_scheduler;							//!< Runs steps of independent meshes in parallel
+	std::vector<int> m_stepCounts;						//!< Steps run by each task of last update
+	PathCache m_pathCache;								//!< Results of finished searches (simulation thread)
+	SimulationClock m_simulationClock;					//!< Number of solver steps run per tick
+	bool m_isPaused{ true };							//!< Are solvers and generator stopped (simulation thread)
+	TripleBuffer<GridSnapshot> m_snapshots;				//!< Hand-over of mesh state from simulation to render thread
+	std::thread m_simulationThread;						//!< Thread running solvers, generator and edits
+	std::mutex m_commandMutex;							//!< Guards queued commands and stop request
+	std::condition_variable m_commandCondition;			//!< Signals queued command or stop request
+	std::vector<std::function<void()>> m_commands;		//!< Commands waiting for simulation thread
+	bool m_isStopping{ false };							//!< Simulation thread should finish
 };
\ No newline at end of file
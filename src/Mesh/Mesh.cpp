@@ -1,13 +1,77 @@
 #include "Mesh.h"
+#include <cstring>
 
 const int TEXT_SIZE = 20;
 
+/// <summary>
+/// Mix bytes of plane into hash, eight bytes at a time
+/// </summary>
+/// <param name="hash">Current hash</param>
+/// <param name="data">Bytes of plane</param>
+/// <param name="size">Number of bytes</param>
+/// <returns>Updated hash</returns>
+std::uint64_t hashBytes(std::uint64_t hash, const std::uint8_t* data, std::size_t size)
+{
+	constexpr std::uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ull;
+	for (std::size_t i = 0; i < size; i += 8)
+	{
+		std::uint64_t word = 0;
+		std::memcpy(&word, data + i, std::min<std::size_t>(8, size - i));
+		// Rotation carries high bits back down, so every byte influences whole hash
+		hash = (((hash << 5) | (hash >> 59)) ^ word) * MULTIPLIER;
+	}
+	return hash;
+}
+
+/// <summary>
+/// Get color in which cell of given type is drawn
+/// </summary>
+/// <param name="sqType">Type shown by cell</param>
+/// <returns>Color of cell</returns>
+sf::Color getSquareColor(SquareType sqType)
+{
+	switch (sqType)
+	{
+		case SquareType::FULL:
+			return sf::Color(110, 110, 110);
+		case SquareType::START:
+			return sf::Color::Green;
+		case SquareType::FINISH:
+			return sf::Color::Red;
+		case SquareType::QUEUED:
+			return sf::Color(128, 0, 128);
+		case SquareType::UNFINISHED:
+			return sf::Color(0, 191, 255);
+		case SquareType::PROCESSED:
+			return sf::Color(160, 82, 45);
+		case SquareType::PROCESSED2:
+			return sf::Color(244, 164, 96);
+		case SquareType::PATH:
+			return sf::Color::Yellow;
+		default:
+			return sf::Color::White;
+	}
+}
+
 ////////////////////////////////////////////////////////////
 Mesh::Mesh(sf::Vector2f position, sf::Vector2i meshSize, unsigned cellSize)
 	: m_positions{ position }, m_size{ meshSize }, m_cellSize{ cellSize }, m_quads{ sf::Quads }, m_lines{ sf::Lines }
 {
 	// Reserve memory for all elements
-	m_squareVec.resize(meshSize.x * meshSize.y);
+	int cellCount = meshSize.x * meshSize.y;
+	m_cellTypes.resize(cellCount, SquareType::EMPTY);
+	m_cellWeights.resize(cellCount, MIN_CELL_WEIGHT);
+	m_searchState.resize(cellCount);
+	m_cellColors.resize(cellCount, SquareType::EMPTY);
+	m_shownColors.resize(cellCount, SquareType::EMPTY);
+	m_borderedTerrain.resize((meshSize.x + 2) * (meshSize.y + 2));
+	m_neighbourMasks.resize(cellCount);
+	m_componentIndex.resize(meshSize.x, meshSize.y);
+	for (int i = 0; i < 8; ++i)
+	{
+		m_neighbourOffsets[i] = DIRECTION_ROW_OFFSET[NEIGHBOUR_DIRECTIONS[i]] * meshSize.x + DIRECTION_COL_OFFSET[NEIGHBOUR_DIRECTIONS[i]];
+		m_borderedOffsets[i] = DIRECTION_ROW_OFFSET[NEIGHBOUR_DIRECTIONS[i]] * (meshSize.x + 2) + DIRECTION_COL_OFFSET[NEIGHBOUR_DIRECTIONS[i]];
+	}
 	m_quads.resize(meshSize.x * meshSize.y * 4);
 	m_lines.resize((meshSize.x + 1) * (meshSize.y + 1) * 2);
 
@@ -52,28 +116,30 @@ Mesh::Mesh(sf::Vector2f position, sf::Vector2i meshSize, unsigned cellSize)
 	}
 	// Create start and end point
 	int startPoint = 0;
-	int endPoint = static_cast<int>(m_squareVec.size() - 1);
-	m_squareVec[startPoint].cellType = SquareType::START;
-	m_squareVec[startPoint].distance = 0;
-	m_squareVec[endPoint].cellType = SquareType::FINISH;
+	int endPoint = cellCount - 1;
+	m_cellTypes[startPoint] = SquareType::START;
+	m_cellTypes[endPoint] = SquareType::FINISH;
 	setCellColor(SquareType::START, startPoint);
 	setCellColor(SquareType::FINISH, endPoint);
 	m_startIndex = startPoint;
 	m_endIndex = endPoint;
+	rebuildNeighbourhood();
+	beginSearch();
 }
 
 ////////////////////////////////////////////////////////////
-void Mesh::draw(sf::RenderTarget& target, const sf::Font& font, bool drawSquares, bool drawLines, bool drawWeights)
+void Mesh::draw(sf::RenderTarget& target, const sf::Font& font, const MeshSnapshot& snapshot, bool drawSquares, bool drawLines, bool drawWeights)
 {
 	if (drawSquares)
 	{
+		updateQuads(snapshot);
 		target.draw(m_quads);
 	}
 	if (drawLines)
 	{
 		target.draw(m_lines);
 	}
-	if (drawWeights)
+	if (drawWeights && snapshot.cellWeights.size() == m_shownColors.size())
 	{	
 		sf::Text text;
 		text.setFont(font);
@@ -83,7 +149,7 @@ void Mesh::draw(sf::RenderTarget& target, const sf::Font& font, bool drawSquares
 		{
 			for (int j = 0; j < m_size.y; ++j)
 			{
-				text.setString(std::to_string(m_squareVec[j * m_size.x + i].weight));
+				text.setString(std::to_string(snapshot.cellWeights[j * m_size.x + i]));
 				text.setPosition(sf::Vector2f(m_positions.x + i * m_cellSize, m_positions.y + j * m_cellSize));
 				target.draw(text);
 			}
@@ -92,7 +158,7 @@ void Mesh::draw(sf::RenderTarget& target, const sf::Font& font, bool drawSquares
 }
 
 ////////////////////////////////////////////////////////////
-void Mesh::drawData(sf::RenderTarget& target, const sf::Font& font, std::string solverName, int processedSquare, int pathLength, int pathWeight)
+void Mesh::drawData(sf::RenderTarget& target, const sf::Font& font, std::string solverName, int processedSquare, int pathLength, int pathWeight, float stepTime)
 {
 	float rectX = m_positions.x;
 	float rectY = m_positions.y;
@@ -106,7 +172,7 @@ void Mesh::drawData(sf::RenderTarget& target, const sf::Font& font, std::string
 	float textY = rectY - (text.getLocalBounds().height * 1.5f);
 	// Draw solver name
 	text.setPosition(textX, textY);
-	text.move(0.0f, -TEXT_SIZE * 4);
+	text.move(0.0f, -TEXT_SIZE * 5);
 	target.draw(text);
 	// Draw processed squares
 	text.move(0.0f, TEXT_SIZE);
@@ -120,6 +186,21 @@ void Mesh::drawData(sf::RenderTarget& target, const sf::Font& font, std::string
 	text.move(0.0f, TEXT_SIZE);
 	text.setString("Path weight: " + std::to_string(pathWeight));
 	target.draw(text);
+	// Draw time of last step
+	text.move(0.0f, TEXT_SIZE);
+	text.setString("Step time: " + std::to_string(static_cast<int>(stepTime)) + " us");
+	target.draw(text);
+}
+
+////////////////////////////////////////////////////////////
+void Mesh::drawCaption(sf::RenderTarget& target, const sf::Font& font, const std::string& caption)
+{
+	float rectWidth = static_cast<float>(m_size.x * m_cellSize);
+
+	sf::Text text(caption, font, TEXT_SIZE);
+	text.setFillColor(sf::Color::Black);
+	text.setPosition(m_positions.x + (rectWidth / 2) - (text.getLocalBounds().width / 2), m_positions.y - TEXT_SIZE * 2);
+	target.draw(text);
 }
 
 ////////////////////////////////////////////////////////////
@@ -147,44 +228,61 @@ void Mesh::setCellType(sf::Vector2f mousePos, SquareType squareType)
 	// Get cell index
 	int col = static_cast<int>(mousePos.x - m_positions.x) / m_cellSize;
 	int row = static_cast<int>(mousePos.y - m_positions.y) / m_cellSize;
-	int index = row * m_size.x + col;
+	setCellType(row * m_size.x + col, squareType);
+}
 
+////////////////////////////////////////////////////////////
+void Mesh::setCellType(int index, SquareType squareType)
+{
 	// Modify cell if index is in range
-	if (index >= 0 && index < m_squareVec.size())
+	if (index >= 0 && index < m_cellTypes.size())
 	{
-		SquareType modifiedSquareType = m_squareVec[index].cellType;
+		SquareType modifiedSquareType = m_cellTypes[index];
 
 		if (modifiedSquareType != SquareType::START && modifiedSquareType != SquareType::FINISH)
 		{
+			// Moving start or finish also changes the cell it leaves
+			int replacedIndex = -1;
 			if (squareType == SquareType::START)
 			{
+				replacedIndex = m_startIndex;
 				// Reset current start cell
-				m_squareVec[m_startIndex].cellType = SquareType::EMPTY;
-				m_squareVec[m_startIndex].distance = std::numeric_limits<int>::max();
+				m_cellTypes[m_startIndex] = SquareType::EMPTY;
+				m_searchState.unvisit(m_startIndex);
 				setCellColor(SquareType::EMPTY, m_startIndex);
 				// Reset new start cell
-				m_squareVec[index].cellType = SquareType::START;
-				m_squareVec[index].distance = 0;
+				m_cellTypes[index] = SquareType::START;
+				m_searchState.visit(index, SquareType::START);
+				m_searchState.setDistance(index, 0);
 				setCellColor(SquareType::START, index);
 				// Change start position
 				m_startIndex = index;
 			}
 			else if (squareType == SquareType::FINISH)
 			{
+				replacedIndex = m_endIndex;
 				// Reset finish cell
-				m_squareVec[m_endIndex].cellType = SquareType::EMPTY;
+				m_cellTypes[m_endIndex] = SquareType::EMPTY;
 				setCellColor(SquareType::EMPTY, m_endIndex);
 				// Reset start cell
-				m_squareVec[index].cellType = SquareType::FINISH;
+				m_cellTypes[index] = SquareType::FINISH;
 				setCellColor(SquareType::FINISH, index);
 				// Change end position
 				m_endIndex = index;
 			}
 			else
 			{
-				m_squareVec[index].cellType = squareType;
+				m_cellTypes[index] = squareType;
 				setCellColor(squareType, index);
 			}
+			m_revision++;
+			updateNeighbourhood(index);
+			recordEdit(index);
+			if (replacedIndex != -1)
+			{
+				updateNeighbourhood(replacedIndex);
+				recordEdit(replacedIndex);
+			}
 		}
 	}
 }
@@ -197,10 +295,11 @@ void Mesh::addCellWeight(sf::Vector2f mousePos)
 	int row = static_cast<int>(mousePos.y - m_positions.y) / m_cellSize;
 	int index = row * m_size.x + col;
 
-	int currentWeight = m_squareVec[index].weight;
-	if (currentWeight != 9)
+	if (m_cellWeights[index] != MAX_CELL_WEIGHT)
 	{
-		m_squareVec[index].weight++;
+		m_cellWeights[index]++;
+		m_revision++;
+		recordEdit(index);
 	}
 }
 
@@ -212,103 +311,292 @@ void Mesh::subCellWeight(sf::Vector2f mousePos)
 	int row = static_cast<int>(mousePos.y - m_positions.y) / m_cellSize;
 	int index = row * m_size.x + col;
 
-	int currentWeight = m_squareVec[index].weight;
-	if (currentWeight != 1)
+	if (m_cellWeights[index] != MIN_CELL_WEIGHT)
 	{
-		m_squareVec[index].weight--;
+		m_cellWeights[index]--;
+		m_revision++;
+		recordEdit(index);
 	}
 }
 
 ////////////////////////////////////////////////////////////
 void Mesh::copyMesh(const Mesh& mesh)
 {
-	for (int i = 0; i < mesh.m_squareVec.size(); ++i)
+	m_cellTypes = mesh.m_cellTypes;
+	m_cellWeights = mesh.m_cellWeights;
+	m_startIndex = mesh.getStartPosition();
+	m_endIndex = mesh.getFinishPosition();
+	for (int i = 0; i < m_cellTypes.size(); ++i)
 	{
-		m_squareVec[i] = mesh.m_squareVec[i];
-		m_startIndex = mesh.getStartPosition();
-		m_endIndex = mesh.getFinishPosition();
-		setCellColor(m_squareVec[i].cellType, i);
+		setCellColor(m_cellTypes[i], i);
 	}
+	m_paintedCells.clear();
+	rebuildNeighbourhood();
+	m_revision++;
+	resetEditLog();
+	beginSearch();
 }
 
 ////////////////////////////////////////////////////////////
 void Mesh::resetMesh()
 {
-	for (int i = 0; i < m_squareVec.size(); ++i)
+	for (int index : m_paintedCells)
 	{
-		if (m_squareVec[i].cellType != SquareType::FINISH && m_squareVec[i].cellType != SquareType::START && m_squareVec[i].cellType != SquareType::FULL)
-		{
-			m_squareVec[i].cellType = SquareType::EMPTY;
-			m_squareVec[i].distance = std::numeric_limits<int>::max();
-			setCellColor(SquareType::EMPTY, i);
-		}
+		setCellColor(m_cellTypes[index], index);
 	}
+	m_paintedCells.clear();
+	beginSearch();
 }
 
 ////////////////////////////////////////////////////////////
 void Mesh::clearMesh()
 {
 	// Set all cells to empty
-	for (int i = 0; i < m_squareVec.size(); ++i)
+	for (int i = 0; i < m_cellTypes.size(); ++i)
 	{
-		m_squareVec[i].cellType = SquareType::EMPTY;
-		m_squareVec[i].distance = std::numeric_limits<int>::max();
+		m_cellTypes[i] = SquareType::EMPTY;
 		setCellColor(SquareType::EMPTY, i);
 	}
+	m_paintedCells.clear();
 	// Create start and finish
 	int startPoint = 0;
-	int endPoint = static_cast<int>(m_squareVec.size() - 1);
-	m_squareVec[startPoint].cellType = SquareType::START;
-	m_squareVec[startPoint].distance = 0;
-	m_squareVec[endPoint].cellType = SquareType::FINISH;
+	int endPoint = getCellCount() - 1;
+	m_cellTypes[startPoint] = SquareType::START;
+	m_cellTypes[endPoint] = SquareType::FINISH;
 	setCellColor(SquareType::START, startPoint);
 	setCellColor(SquareType::FINISH, endPoint);
 	m_startIndex = startPoint;
 	m_endIndex = endPoint;
+	rebuildNeighbourhood();
+	m_revision++;
+	resetEditLog();
+	beginSearch();
 }
 
 ////////////////////////////////////////////////////////////
 void Mesh::setCellColor(SquareType sqType, int index)
 {
-	// Get new color
-	sf::Color color;
 	switch (sqType)
 	{
-		case SquareType::EMPTY:
-			color = sf::Color::White;
-			break;
-		case SquareType::FULL:
-			color = sf::Color(110, 110, 110);
-			break;
-		case SquareType::START:
-			color = sf::Color::Green;
-			break;
-		case SquareType::FINISH:
-			color = sf::Color::Red;
-			break;
 		case SquareType::QUEUED:
-			color = sf::Color(128, 0, 128);
-			break;
 		case SquareType::UNFINISHED:
-			color = sf::Color(0, 191, 255);
-			break;
 		case SquareType::PROCESSED:
-			color = sf::Color(160, 82, 45);
-			break;
 		case SquareType::PROCESSED2:
-			color = sf::Color(244, 164, 96);
-			break;
 		case SquareType::PATH:
-			color = sf::Color::Yellow;
+			m_paintedCells.push_back(index);
 			break;
 		default:
-			color = sf::Color::White;
 			break;
 	}
-	// Change vertex color
-	int vertexIndex = index * 4;
-	m_quads[vertexIndex].color = color;
-	m_quads[vertexIndex + 1].color = color;
-	m_quads[vertexIndex + 2].color = color;
-	m_quads[vertexIndex + 3].color = color;
+	m_cellColors[index] = sqType;
+	m_colorRevision++;
+}
+
+////////////////////////////////////////////////////////////
+void Mesh::takeSnapshot(MeshSnapshot& snapshot) const
+{
+	// Buffers are reused, so only planes changed since this buffer was filled are copied
+	if (snapshot.cellColors.size() != m_cellColors.size() || snapshot.colorRevision != m_colorRevision)
+	{
+		snapshot.cellColors = m_cellColors;
+		snapshot.colorRevision = m_colorRevision;
+	}
+	if (snapshot.cellWeights.size() != m_cellWeights.size() || snapshot.revision != m_revision)
+	{
+		snapshot.cellWeights = m_cellWeights;
+		snapshot.revision = m_revision;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void Mesh::updateQuads(const MeshSnapshot& snapshot)
+{
+	if (snapshot.cellColors.size() != m_shownColors.size() || snapshot.colorRevision == m_shownColorRevision)
+	{
+		return;
+	}
+	for (int index = 0; index < static_cast<int>(m_shownColors.size()); ++index)
+	{
+		if (snapshot.cellColors[index] == m_shownColors[index])
+		{
+			continue;
+		}
+		m_shownColors[index] = snapshot.cellColors[index];
+		sf::Color color = getSquareColor(m_shownColors[index]);
+		// Change vertex color
+		int vertexIndex = index * 4;
+		m_quads[vertexIndex].color = color;
+		m_quads[vertexIndex + 1].color = color;
+		m_quads[vertexIndex + 2].color = color;
+		m_quads[vertexIndex + 3].color = color;
+	}
+	m_shownColorRevision = snapshot.colorRevision;
+}
+
+////////////////////////////////////////////////////////////
+void Mesh::beginSearch()
+{
+	m_searchState.newSearch();
+	m_searchState.visit(m_startIndex, SquareType::START);
+	m_searchState.setDistance(m_startIndex, 0);
+}
+
+////////////////////////////////////////////////////////////
+void Mesh::rebuildNeighbourhood()
+{
+	m_componentIndex.invalidate();
+	int borderedWidth = m_size.x + 2;
+	std::fill(m_borderedTerrain.begin(), m_borderedTerrain.end(), 0);
+	for (int row = 0; row < m_size.y; ++row)
+	{
+		for (int column = 0; column < m_size.x; ++column)
+		{
+			m_borderedTerrain[(row + 1) * borderedWidth + column + 1] = m_cellTypes[row * m_size.x + column] != SquareType::FULL;
+		}
+	}
+	for (int row = 0; row < m_size.y; ++row)
+	{
+		for (int column = 0; column < m_size.x; ++column)
+		{
+			updateNeighbourMask(row, column);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void Mesh::updateNeighbourhood(int index)
+{
+	int row = index / m_size.x;
+	int column = index % m_size.x;
+	std::uint8_t& terrain = m_borderedTerrain[(row + 1) * (m_size.x + 2) + column + 1];
+	bool wasOpen = terrain;
+	terrain = m_cellTypes[index] != SquareType::FULL;
+	for (int i = std::max(row - 1, 0); i <= std::min(row + 1, m_size.y - 1); ++i)
+	{
+		for (int j = std::max(column - 1, 0); j <= std::min(column + 1, m_size.x - 1); ++j)
+		{
+			updateNeighbourMask(i, j);
+		}
+	}
+	// Removed wall can only merge regions, added wall may split one, which needs labelling from scratch
+	if (wasOpen && !terrain)
+	{
+		m_componentIndex.invalidate();
+	}
+	else if (!wasOpen && terrain && m_componentIndex.isValid())
+	{
+		m_componentIndex.openCell(index);
+		for (auto [nextIndex, direction] : getNeighbours(index))
+		{
+			m_componentIndex.joinCells(index, nextIndex);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void Mesh::updateNeighbourMask(int row, int column)
+{
+	// Border cells are walls, so neighbours outside mesh drop out without bounds checks
+	const std::uint8_t* terrain = &m_borderedTerrain[(row + 1) * (m_size.x + 2) + column + 1];
+	std::uint8_t mask = 0;
+	for (int i = 0; i < 8; ++i)
+	{
+		mask |= terrain[m_borderedOffsets[i]] << i;
+	}
+	m_neighbourMasks[row * m_size.x + column] = mask;
+}
+
+////////////////////////////////////////////////////////////
+bool Mesh::getEditedCells(std::uint32_t revision, std::vector<int>& cells) const
+{
+	cells.clear();
+	if (revision - m_editLogBase > m_revision - m_editLogBase)
+	{
+		// Revision is older than last change of whole mesh
+		return false;
+	}
+	auto it = std::upper_bound(m_editLog.begin(), m_editLog.end(), revision, [this](std::uint32_t value, const std::pair<std::uint32_t, int>& edit)
+		{
+			return value - m_editLogBase < edit.first - m_editLogBase;
+		});
+	for (; it != m_editLog.end(); ++it)
+	{
+		cells.push_back(it->second);
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void Mesh::recordEdit(int index)
+{
+	if (m_editLog.size() >= MAX_EDIT_LOG)
+	{
+		// Readers which did not keep up rebuild everything
+		resetEditLog();
+		return;
+	}
+	m_editLog.emplace_back(m_revision, index);
+}
+
+////////////////////////////////////////////////////////////
+void Mesh::resetEditLog()
+{
+	m_editLog.clear();
+	m_editLogBase = m_revision;
+}
+
+////////////////////////////////////////////////////////////
+std::uint64_t Mesh::getContentHash() const
+{
+	if (!m_isHashValid || m_hashRevision != m_revision)
+	{
+		std::uint64_t hash = hashBytes(static_cast<std::uint64_t>(m_size.x) << 32 | static_cast<std::uint32_t>(m_size.y),
+			reinterpret_cast<const std::uint8_t*>(m_cellTypes.data()), m_cellTypes.size());
+		hash = hashBytes(hash, m_cellWeights.data(), m_cellWeights.size());
+		// Final avalanche so nearby contents give unrelated hashes
+		hash ^= hash >> 31;
+		hash *= 0xBF58476D1CE4E5B9ull;
+		hash ^= hash >> 29;
+		m_contentHash = hash;
+		m_hashRevision = m_revision;
+		m_isHashValid = true;
+	}
+	return m_contentHash;
+}
+
+////////////////////////////////////////////////////////////
+std::uint8_t Mesh::getMinCellWeight() const
+{
+	if (!m_isMinWeightValid || m_minWeightRevision != m_revision)
+	{
+		std::uint8_t minWeight = MAX_CELL_WEIGHT + 1;
+		for (size_t i = 0; i < m_cellTypes.size(); ++i)
+		{
+			if (m_cellTypes[i] != SquareType::FULL)
+			{
+				minWeight = std::min(minWeight, m_cellWeights[i]);
+			}
+		}
+		m_minCellWeight = minWeight > MAX_CELL_WEIGHT ? MIN_CELL_WEIGHT : minWeight;
+		m_minWeightRevision = m_revision;
+		m_isMinWeightValid = true;
+	}
+	return m_minCellWeight;
+}
+
+////////////////////////////////////////////////////////////
+bool Mesh::areConnected(int first, int second)
+{
+	int component = getComponent(first);
+	return component != -1 && component == getComponent(second);
+}
+
+////////////////////////////////////////////////////////////
+int Mesh::getComponent(int index)
+{
+	if (!m_componentIndex.isValid())
+	{
+		m_componentIndex.build(m_cellTypes, m_threadCount);
+	}
+	return m_componentIndex.getComponent(index);
 }
\ No newline at end of file
@@ -1,11 +1,17 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "ComponentIndex.h"
+#include "src/Utility/BitOperations.h"
+#include <algorithm>
+#include <cstdint>
 #include <limits>
+#include <thread>
+#include <vector>
 
 /// <summary>
 /// Type of squares on mesh
 /// </summary>
-enum class SquareType
+enum class SquareType : std::uint8_t
 {
 	EMPTY,
 	START,
@@ -19,15 +25,176 @@ enum class SquareType
 };
 
 /// <summary>
-/// Representation of each cell in mesh
+/// Row offsets of moves encoded by direction code
 /// </summary>
-struct Cell
+inline constexpr int DIRECTION_ROW_OFFSET[9] = { -1, -1, -1, 0, 0, 0, 1, 1, 1 };
+/// <summary>
+/// Column offsets of moves encoded by direction code
+/// </summary>
+inline constexpr int DIRECTION_COL_OFFSET[9] = { -1, 0, 1, -1, 0, 1, -1, 0, 1 };
+/// <summary>
+/// Direction codes of neighbour slots (row by row, without the cell itself)
+/// </summary>
+inline constexpr std::uint8_t NEIGHBOUR_DIRECTIONS[8] = { 0, 1, 2, 3, 5, 6, 7, 8 };
+
+/// <summary>
+/// Neighbours of a cell which are inside mesh and are not walls, iterated in direction code order.
+/// Each step is a constant offset taken from set bit of precomputed mask, so there are no bounds checks and no division.
+/// </summary>
+class NeighbourRange
+{
+public:
+	/// <summary>
+	/// Neighbour cell together with direction code of the move into it
+	/// </summary>
+	struct Neighbour
+	{
+		int index;					//!< Index of neighbour cell
+		std::uint8_t direction;		//!< Direction code of move from cell to neighbour
+	};
+	/// <summary>
+	/// Iterator over set bits of neighbour mask
+	/// </summary>
+	class Iterator
+	{
+	public:
+		Iterator(int index, unsigned mask, const int* offsets) : m_index{ index }, m_mask{ mask }, m_offsets{ offsets } {}
+		Neighbour operator*() const
+		{
+			int slot = countTrailingZeros(m_mask);
+			return { m_index + m_offsets[slot], NEIGHBOUR_DIRECTIONS[slot] };
+		}
+		Iterator& operator++()
+		{
+			m_mask &= m_mask - 1;
+			return *this;
+		}
+		bool operator!=(const Iterator& other) const { return m_mask != other.m_mask; }
+	private:
+		int m_index;				//!< Index of cell
+		unsigned m_mask;			//!< Neighbour slots left to visit
+		const int* m_offsets;		//!< Index offsets of neighbour slots
+	};
+	NeighbourRange(int index, unsigned mask, const int* offsets) : m_index{ index }, m_mask{ mask }, m_offsets{ offsets } {}
+	Iterator begin() const { return Iterator(m_index, m_mask, m_offsets); }
+	Iterator end() const { return Iterator(m_index, 0, m_offsets); }
+private:
+	int m_index;				//!< Index of cell
+	unsigned m_mask;			//!< Neighbour slots which can be entered
+	const int* m_offsets;		//!< Index offsets of neighbour slots
+};
+
+/// <summary>
+/// Per-solve cell state (state, distance and parent planes) tagged with search epoch.
+/// Cell data is valid only if its stamp matches current epoch, so starting a new search only bumps a counter.
+/// </summary>
+class SearchState
+{
+public:
+	/// <summary>
+	/// Allocate planes for given number of cells
+	/// </summary>
+	/// <param name="cellCount">Number of cells</param>
+	void resize(int cellCount)
+	{
+		m_states.resize(cellCount);
+		m_distances.resize(cellCount);
+		m_parents.resize(cellCount);
+		m_stamps.assign(cellCount, 0);
+		m_epoch = 1;
+	}
+	/// <summary>
+	/// Invalidate all cells (start new search)
+	/// </summary>
+	void newSearch()
+	{
+		if (++m_epoch == 0)
+		{
+			// Epoch wrapped around, stamps from previous cycle could match again
+			std::fill(m_stamps.begin(), m_stamps.end(), 0);
+			m_epoch = 1;
+		}
+	}
+	/// <summary>
+	/// Check if cell was touched in current search
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>True if cell was visited</returns>
+	bool isVisited(int index) const { return m_stamps[index] == m_epoch; }
+	/// <summary>
+	/// Mark cell as visited in current search
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <param name="state">New state of cell</param>
+	void visit(int index, SquareType state)
+	{
+		m_stamps[index] = m_epoch;
+		m_states[index] = state;
+	}
+	/// <summary>
+	/// Mark cell as not visited in current search
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	void unvisit(int index) { m_stamps[index] = 0; }
+	/// <summary>
+	/// Get state of cell
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>State of cell (EMPTY if cell was not visited)</returns>
+	SquareType getState(int index) const { return isVisited(index) ? m_states[index] : SquareType::EMPTY; }
+	/// <summary>
+	/// Get distance of cell from start
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Distance (max int if cell was not visited)</returns>
+	int getDistance(int index) const { return isVisited(index) ? m_distances[index] : std::numeric_limits<int>::max(); }
+	/// <summary>
+	/// Get direction code of the move which reached the cell (valid only for visited cells)
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Parent direction</returns>
+	std::uint8_t getParent(int index) const { return m_parents[index]; }
+	/// <summary>
+	/// Set state of visited cell
+	/// </summary>
+	void setState(int index, SquareType state) { m_states[index] = state; }
+	/// <summary>
+	/// Set distance of visited cell
+	/// </summary>
+	void setDistance(int index, int distance) { m_distances[index] = distance; }
+	/// <summary>
+	/// Set parent direction of visited cell
+	/// </summary>
+	void setParent(int index, std::uint8_t direction) { m_parents[index] = direction; }
+	/// <summary>
+	/// Get current search epoch
+	/// </summary>
+	/// <returns>Search epoch</returns>
+	std::uint32_t getEpoch() const { return m_epoch; }
+private:
+	std::vector<SquareType> m_states;		//!< State plane (queued/processed/path)
+	std::vector<int> m_distances;			//!< Distance plane
+	std::vector<std::uint8_t> m_parents;	//!< Parent plane (direction code of the move which reached the cell)
+	std::vector<std::uint32_t> m_stamps;	//!< Epoch in which cell was last visited
+	std::uint32_t m_epoch{ 1 };				//!< Current search epoch
+};
+
+/// <summary>
+/// Copy of mesh planes needed for drawing, taken by simulation thread and read by render thread
+/// </summary>
+struct MeshSnapshot
 {
-	SquareType cellType{ SquareType::EMPTY };					//!< Type of cell
-	int		   distance{ std::numeric_limits<int>::max() };		//!< Distance from start
-	int		   weight{ 1 };										//!< Cell weight
+	std::vector<SquareType> cellColors;		//!< Type shown by each cell
+	std::vector<std::uint8_t> cellWeights;	//!< Weight of each cell
+	std::uint32_t colorRevision{};			//!< Colour revision of mesh when colours were copied
+	std::uint32_t revision{};				//!< Grid revision of mesh when weights were copied
 };
 
+/// <summary>
+/// Grid of cells searched by solvers.
+/// Cell planes and colour plane belong to simulation thread. Vertex arrays belong to render thread and are updated only from snapshots,
+/// so simulation never waits for drawing.
+/// </summary>
 class Mesh
 {
 public:
@@ -39,14 +206,22 @@ public:
 	/// <param name="squareSize">Size of each square</param>
 	Mesh(sf::Vector2f position, sf::Vector2i meshSize, unsigned cellSize);
 	/// <summary>
-	/// Draw mesh
+	/// Draw mesh as captured in snapshot (render thread)
 	/// </summary>
 	/// <param name="target">Target to draw</param>
-	void draw(sf::RenderTarget& target, const sf::Font& font, bool drawSquares, bool drawLines, bool drawWeights);
+	/// <param name="snapshot">Snapshot of this mesh</param>
+	void draw(sf::RenderTarget& target, const sf::Font& font, const MeshSnapshot& snapshot, bool drawSquares, bool drawLines, bool drawWeights);
 	/// <summary>
 	/// Draw solver results
 	/// </summary>
-	void drawData(sf::RenderTarget& target, const sf::Font& font, std::string solverName, int processedSquare, int pathLength, int pathWeight);
+	void drawData(sf::RenderTarget& target, const sf::Font& font, std::string solverName, int processedSquare, int pathLength, int pathWeight, float stepTime);
+	/// <summary>
+	/// Draw one line of text centred above mesh
+	/// </summary>
+	/// <param name="target">Target to draw</param>
+	/// <param name="font">Font of text</param>
+	/// <param name="caption">Text to draw</param>
+	void drawCaption(sf::RenderTarget& target, const sf::Font& font, const std::string& caption);
 	/// <summary>
 	/// Check if mesh is visible in current view
 	/// </summary>
@@ -66,6 +241,12 @@ public:
 	/// <param name="squareType">Type of cell</param>
 	void setCellType(sf::Vector2f mousePos,SquareType squareType);
 	/// <summary>
+	/// Activate cell (start and finish cells are kept)
+	/// </summary>
+	/// <param name="index">Index of cell to activate</param>
+	/// <param name="squareType">Type of cell</param>
+	void setCellType(int index, SquareType squareType);
+	/// <summary>
 	/// Add weight to cell
 	/// </summary>
 	/// <param name="mousePos">Position of cell to activate (mouse click pos)</param>
@@ -82,6 +263,7 @@ public:
 	void copyMesh(const Mesh& mesh);
 	/// <summary>
 	/// Reset mesh (Clear all cells changed my solver)
+	/// Starts new search epoch and repaints only cells coloured by solver
 	/// </summary>
 	void resetMesh();
 	/// <summary>
@@ -89,6 +271,11 @@ public:
 	/// </summary>
 	void clearMesh();
 	/// <summary>
+	/// Copy planes needed for drawing, skipping planes which did not change since snapshot was taken last time
+	/// </summary>
+	/// <param name="snapshot">Snapshot to update</param>
+	void takeSnapshot(MeshSnapshot& snapshot) const;
+	/// <summary>
 	/// Change color of a cell with index
 	/// </summary>
 	/// <param name="sqType">New type of cell</param>
@@ -110,18 +297,155 @@ public:
 	/// <returns>Start position</returns>
 	int getFinishPosition()const { return m_endIndex; };
 	/// <summary>
-	/// Get vector of square types
+	/// Get number of cells in mesh
+	/// </summary>
+	/// <returns>Number of cells</returns>
+	int getCellCount()const { return static_cast<int>(m_cellTypes.size()); }
+	/// <summary>
+	/// Get static terrain plane (EMPTY/FULL/START/FINISH)
+	/// </summary>
+	/// <returns>Vector of cell types</returns>
+	const std::vector<SquareType>& getCellTypes()const { return m_cellTypes; }
+	/// <summary>
+	/// Get weight plane
+	/// </summary>
+	/// <returns>Vector of cell weights</returns>
+	const std::vector<std::uint8_t>& getCellWeights()const { return m_cellWeights; }
+	/// <summary>
+	/// Get per-solve search state (state, distance and parent planes)
+	/// </summary>
+	/// <returns>Search state</returns>
+	SearchState& getSearchState() { return m_searchState; }
+	/// <summary>
+	/// Get revision of terrain and weight planes (changes on every edit made through Mesh methods)
+	/// </summary>
+	/// <returns>Grid revision</returns>
+	std::uint32_t getRevision()const { return m_revision; }
+	/// <summary>
+	/// Get cells edited after given revision (type or weight changed through Mesh methods)
+	/// </summary>
+	/// <param name="revision">Revision seen by caller</param>
+	/// <param name="cells">Edited cells (may repeat)</param>
+	/// <returns>False if edits since that revision are no longer recorded (whole mesh has to be treated as changed)</returns>
+	bool getEditedCells(std::uint32_t revision, std::vector<int>& cells)const;
+	/// <summary>
+	/// Get hash of cell types and weights (computed at most once per revision)
+	/// </summary>
+	/// <returns>Content hash, equal for meshes with equal types and weights</returns>
+	std::uint64_t getContentHash()const;
+	/// <summary>
+	/// Get lowest weight of cells which are not walls (computed at most once per revision)
+	/// </summary>
+	/// <returns>Lowest weight, MIN_CELL_WEIGHT if every cell is wall</returns>
+	std::uint8_t getMinCellWeight()const;
+	/// <summary>
+	/// Check if path can exist between two cells (labels regions first if walls were added since last check)
+	/// </summary>
+	/// <param name="first">Index of first cell</param>
+	/// <param name="second">Index of second cell</param>
+	/// <returns>True if both cells lie in the same region of open cells</returns>
+	bool areConnected(int first, int second);
+	/// <summary>
+	/// Get region of open cells containing cell (labels regions first if walls were added since last check)
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Lowest index of region cells (-1 for wall)</returns>
+	int getComponent(int index);
+	/// <summary>
+	/// Set number of threads labelling regions
+	/// </summary>
+	/// <param name="threadCount">Thread count (1 labels on calling thread)</param>
+	void setThreadCount(int threadCount) { m_threadCount = threadCount; }
+	/// <summary>
+	/// Get neighbours of cell which are inside mesh and are not walls (canonical neighbour iteration for solvers)
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Range of neighbours</returns>
+	NeighbourRange getNeighbours(int index)const { return NeighbourRange(index, m_neighbourMasks[index], m_neighbourOffsets); }
+	/// <summary>
+	/// Get neighbours of cell which can be entered by moves of given connectivity policy
+	/// </summary>
+	/// <typeparam name="Connectivity">Policy filtering neighbour slots (see SearchPolicies.h)</typeparam>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Range of neighbours</returns>
+	template<typename Connectivity>
+	NeighbourRange getNeighbours(int index)const { return NeighbourRange(index, Connectivity::filterMask(m_neighbourMasks[index]), m_neighbourOffsets); }
+	/// <summary>
+	/// Get mask of neighbour slots of cell which are inside mesh and are not walls
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Bit i is set if neighbour in direction NEIGHBOUR_DIRECTIONS[i] can be entered</returns>
+	std::uint8_t getNeighbourMask(int index)const { return m_neighbourMasks[index]; }
+public:
+	static constexpr std::uint8_t MIN_CELL_WEIGHT = 1;	//!< Minimum weight of a cell
+	static constexpr std::uint8_t MAX_CELL_WEIGHT = 9;	//!< Maximum weight of a cell
+	static constexpr int MAX_EDIT_LOG = 1 << 16;			//!< Number of recorded edits after which log is dropped
+private:
+	/// <summary>
+	/// Start new search epoch with start cell at distance 0
+	/// </summary>
+	void beginSearch();
+	/// <summary>
+	/// Rebuild bordered terrain and neighbour masks of all cells
+	/// </summary>
+	void rebuildNeighbourhood();
+	/// <summary>
+	/// Update bordered terrain of cell and neighbour masks of cells around it
+	/// </summary>
+	/// <param name="index">Index of changed cell</param>
+	void updateNeighbourhood(int index);
+	/// <summary>
+	/// Recompute neighbour mask of cell from bordered terrain
+	/// </summary>
+	/// <param name="row">Row of cell</param>
+	/// <param name="column">Column of cell</param>
+	void updateNeighbourMask(int row, int column);
+	/// <summary>
+	/// Record edit of cell made in current revision
+	/// </summary>
+	/// <param name="index">Index of edited cell</param>
+	void recordEdit(int index);
+	/// <summary>
+	/// Forget recorded edits after change of whole mesh
+	/// </summary>
+	void resetEditLog();
+	/// <summary>
+	/// Repaint quads of cells whose colour in snapshot differs from shown one
 	/// </summary>
-	/// <returns>Vector of square types</returns>
-	std::vector<Cell>& getSquareVec() { return m_squareVec; }
+	/// <param name="snapshot">Snapshot of this mesh</param>
+	void updateQuads(const MeshSnapshot& snapshot);
 private:
 	sf::Vector2f m_positions;				//!< Mesh position in world
 	sf::Vector2i m_size;					//!< Number of cells in mesh
-	std::vector<Cell>	m_squareVec;		//!< Vector of square types (for drawing)
+	// Cell planes
+	std::vector<SquareType> m_cellTypes;	//!< Static terrain plane (walls, start and finish)
+	std::vector<std::uint8_t> m_cellWeights;	//!< Weight plane
+	SearchState m_searchState;				//!< Per-solve state, distance and parent planes
 	unsigned m_cellSize;					//!< Size of each cell (square)
 	int m_startIndex;						//!< Index of start point
 	int m_endIndex;							//!< Index of end point
+	std::uint32_t m_revision{};				//!< Grid revision (bumped on every edit)
+	std::vector<std::pair<std::uint32_t, int>> m_editLog;	//!< Revision and index of cells edited since m_editLogBase
+	std::uint32_t m_editLogBase{};			//!< Revision of last change of whole mesh
+	mutable std::uint64_t m_contentHash{};	//!< Cached content hash
+	mutable std::uint32_t m_hashRevision{};	//!< Revision of cached content hash
+	mutable bool m_isHashValid{ false };	//!< Was content hash computed at least once
+	mutable std::uint8_t m_minCellWeight{};	//!< Cached lowest weight of open cells
+	mutable std::uint32_t m_minWeightRevision{};	//!< Revision of cached lowest weight
+	mutable bool m_isMinWeightValid{ false };	//!< Was lowest weight computed at least once
+	// Neighbourhood
+	std::vector<std::uint8_t> m_borderedTerrain;	//!< Terrain surrounded by one-cell wall border, (width + 2) x (height + 2), 1 if cell can be entered
+	std::vector<std::uint8_t> m_neighbourMasks;		//!< Neighbour slots of each cell which can be entered
+	int m_neighbourOffsets[8];				//!< Index offsets of neighbour slots
+	int m_borderedOffsets[8];				//!< Index offsets of neighbour slots in bordered terrain
+	ComponentIndex m_componentIndex;		//!< Regions of open cells
+	int m_threadCount{ static_cast<int>(std::thread::hardware_concurrency()) };	//!< Threads labelling regions
 	// Drawing
-	sf::VertexArray m_quads;				//!< Vertex array of quads for cell drawing
-	sf::VertexArray m_lines;				//!< Vertex array of lines for inMesh line drawing
+	std::vector<SquareType> m_cellColors;	//!< Colour plane (type shown by each cell)
+	std::uint32_t m_colorRevision{};		//!< Bumped on every change of colour plane
+	std::vector<int> m_paintedCells;		//!< Cells coloured by solver since last reset
+	sf::VertexArray m_quads;				//!< Vertex array of quads for cell drawing (render thread)
+	sf::VertexArray m_lines;				//!< Vertex array of lines for inMesh line drawing (render thread)
+	std::vector<SquareType> m_shownColors;	//!< Colours of quads (render thread)
+	std::uint32_t m_shownColorRevision{};	//!< Colour revision of snapshot shown by quads (render thread)
 };
\ No newline at end of file
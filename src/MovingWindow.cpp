@@ -17,20 +17,20 @@ MovingWindow::MovingWindow(unsigned windowWidth, unsigned windowHeight, std::str
 void MovingWindow::run()
 {
 	Timer t;
+	// Solvers run on their own thread, so slow frames do not slow search down and long steps do not block input
+	m_gridManager.startSimulation();
 	while (m_window.isOpen())
 	{
 		t.start();
 		pollEvent();
-		if (!m_isPaused)
-		{
-			update();
-		}
+		update();
 		m_window.clear(sf::Color(128, 128, 128));
 		draw();
 		m_window.display();
 		t.stop();
 		std::cout << "Frame time: " << t.measure() << std::endl;
 	}
+	m_gridManager.stopSimulation();
 }
 
 ////////////////////////////////////////////////////////////
@@ -82,6 +82,22 @@ void MovingWindow::pollEvent()
 					case sf::Keyboard::P:
 					{
 						m_isPaused = !m_isPaused;
+						m_gridManager.setPaused(m_isPaused);
+						break;
+					}
+					case sf::Keyboard::T:
+					{
+						m_gridManager.switchClockMode();
+						break;
+					}
+					case sf::Keyboard::PageUp:
+					{
+						m_gridManager.speedUp();
+						break;
+					}
+					case sf::Keyboard::PageDown:
+					{
+						m_gridManager.slowDown();
 						break;
 					}
 					case sf::Keyboard::M:
@@ -221,7 +237,7 @@ void MovingWindow::pollEvent()
 ////////////////////////////////////////////////////////////
 void MovingWindow::update()
 {
-	m_gridManager.update();
+	m_gridManager.acquireSnapshot();
 }
 
 ////////////////////////////////////////////////////////////
@@ -27,7 +27,7 @@ private:
 	/// </summary>
 	void pollEvent() override;
 	/// <summary>
-	/// Updates elements of the simulation for the next frame.
+	/// Takes latest state published by simulation thread for the next frame.
 	/// </summary>
 	void update() override;
 	/// <summary>
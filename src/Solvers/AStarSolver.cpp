@@ -1,5 +1,8 @@
 #include "AStarSolver.h"
-#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
 
 /// <summary>
 /// Heuristic function for A* algorithm
@@ -17,132 +20,271 @@ float heuristicFunction(float x1, float y1, float x2, float y2, float weight) {
 }
 
 ////////////////////////////////////////////////////////////
-AStarSolver::AStarSolver(Mesh* mesh) : MeshSolver(mesh)
+template<typename Connectivity, typename Cost>
+AStarSolver<Connectivity, Cost>::AStarSolver(Mesh* mesh, HeapMode heapMode, AStarHeuristic heuristic, float heuristicWeight, int threadCount)
+	: MeshSolver(mesh), m_cellContainer(heapMode), m_heuristic{ heuristic }, m_heuristicWeight{ heuristicWeight }
 {
+	std::string solverName = "A* Solver";
+	switch (heuristic)
+	{
+	case AStarHeuristic::LANDMARKS:
+		// Landmark tables hold cell weight distances, which bound only cell weight cost (with any connectivity)
+		if constexpr (!std::is_same_v<Cost, WeightCost>)
+		{
+			throw std::invalid_argument("Landmark heuristic requires cell weight cost");
+		}
+		m_landmarks = std::make_unique<LandmarkTable>(mesh, LandmarkTable::DEFAULT_LANDMARK_COUNT, threadCount);
+		solverName = "ALT A* Solver";
+		break;
+	case AStarHeuristic::MANHATTAN:
+		solverName = std::string(ManhattanHeuristic::NAME) + " A* Solver";
+		break;
+	case AStarHeuristic::CHEBYSHEV:
+		solverName = std::string(ChebyshevHeuristic::NAME) + " A* Solver";
+		break;
+	case AStarHeuristic::OCTILE:
+		solverName = std::string(OctileHeuristic::NAME) + " A* Solver";
+		break;
+	default:
+		break;
+	}
+	if (heuristicWeight != 1.0f)
+	{
+		char weightText[16];
+		std::snprintf(weightText, sizeof(weightText), " w=%g", heuristicWeight);
+		solverName += weightText;
+	}
+	m_solverName = getPolicyName<Connectivity, Cost>(solverName);
+	m_cellContainer.resize(mesh->getCellCount());
 	reset();
 }
 
 ////////////////////////////////////////////////////////////
-void AStarSolver::reset()
+template<typename Connectivity, typename Cost>
+void AStarSolver<Connectivity, Cost>::reset()
 {
 	resetStartPosition();
 	resetSolver();
 }
 
-void AStarSolver::resetStartPosition()
+template<typename Connectivity, typename Cost>
+void AStarSolver<Connectivity, Cost>::resetStartPosition()
+{
+	m_cellContainer.clear();
+	m_cellContainer.push(m_mesh->getStartPosition(), { 0.0f, 0 });
+	m_stats = AStarStats();
+	m_isInitialised = false;
+}
+
+////////////////////////////////////////////////////////////
+template<typename Connectivity, typename Cost>
+void AStarSolver<Connectivity, Cost>::updateSolver()
+{
+	switch (m_heuristic)
+	{
+	case AStarHeuristic::LANDMARKS:
+		stepSolver<true, AStarHeuristic::LANDMARKS>();
+		break;
+	case AStarHeuristic::MANHATTAN:
+		stepSolver<true, AStarHeuristic::MANHATTAN>();
+		break;
+	case AStarHeuristic::CHEBYSHEV:
+		stepSolver<true, AStarHeuristic::CHEBYSHEV>();
+		break;
+	case AStarHeuristic::OCTILE:
+		stepSolver<true, AStarHeuristic::OCTILE>();
+		break;
+	default:
+		stepSolver<true, AStarHeuristic::EUCLIDEAN>();
+		break;
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<typename Connectivity, typename Cost>
+void AStarSolver<Connectivity, Cost>::updatePath()
 {
-	m_cellContainer = pairPrioQueue();
-	m_cellContainer.push({ m_mesh->getStartPosition(),0.0f });
+	stepParentPath<true>();
 }
 
 ////////////////////////////////////////////////////////////
-void AStarSolver::updateSolver()
+template<typename Connectivity, typename Cost>
+void AStarSolver<Connectivity, Cost>::runSolver()
+{
+	// Heuristic is chosen once per search, so every search loop is specialised for its estimate
+	switch (m_heuristic)
+	{
+	case AStarHeuristic::LANDMARKS:
+		runSearch<AStarHeuristic::LANDMARKS>();
+		break;
+	case AStarHeuristic::MANHATTAN:
+		runSearch<AStarHeuristic::MANHATTAN>();
+		break;
+	case AStarHeuristic::CHEBYSHEV:
+		runSearch<AStarHeuristic::CHEBYSHEV>();
+		break;
+	case AStarHeuristic::OCTILE:
+		runSearch<AStarHeuristic::OCTILE>();
+		break;
+	default:
+		runSearch<AStarHeuristic::EUCLIDEAN>();
+		break;
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<typename Connectivity, typename Cost>
+void AStarSolver<Connectivity, Cost>::runPath()
+{
+	while (!m_isFinished)
+	{
+		stepParentPath<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<typename Connectivity, typename Cost>
+template<AStarHeuristic Heuristic>
+void AStarSolver<Connectivity, Cost>::runSearch()
+{
+	while (!m_isFound && !m_isFinished)
+	{
+		stepSolver<false, Heuristic>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<typename Connectivity, typename Cost>
+template<bool Visualise, AStarHeuristic Heuristic>
+void AStarSolver<Connectivity, Cost>::stepSolver()
 {
 	sf::Vector2i meshSize = m_mesh->getMeshSize();
-	std::vector<Cell>& cellVec = m_mesh->getSquareVec();
-	auto [topIndex, euWeight] = m_cellContainer.top();
-	auto [finishX, finishY] = mapIndex2D(m_mesh->getFinishPosition(), meshSize.x);
-	m_cellContainer.pop();
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	SearchState& searchState = m_mesh->getSearchState();
+	// Tables and costs are refreshed lazily at first step, so edits between searches cost nothing until next search
+	if (!m_isInitialised)
+	{
+		initialiseSearch();
+		m_isInitialised = true;
+	}
+	int topIndex = m_cellContainer.pop().first;
+
+	// Distance to destination is final only once it leaves the queue
+	if (cellTypes[topIndex] == SquareType::FINISH)
+	{
+		m_isFound = true;
+		beginPath(getParentIndex(topIndex, searchState.getParent(topIndex), meshSize.x), Cost::getStraightCost(Mesh::MIN_CELL_WEIGHT));
+		return;
+	}
 	m_squareProcessed++;
+	m_stats.expandedNodes++;
+	int topDistance = searchState.getDistance(topIndex);
 	auto [row, column] = mapIndex2D(topIndex, meshSize.x);
-	for (int i = -1; i <= 1; i++)
+	for (auto [nextIndex, direction] : m_mesh->getNeighbours<Connectivity>(topIndex))
 	{
-		if (row + i < 0 || row + i >= meshSize.y)
+		if (cellTypes[nextIndex] != SquareType::EMPTY && cellTypes[nextIndex] != SquareType::FINISH)
 		{
 			continue;
 		}
-		for (int j = -1; j <= 1; j++)
+		int nextDistance = topDistance + Cost::getMoveCost(cellWeights[nextIndex], direction);
+		if (!searchState.isVisited(nextIndex))
 		{
-			if (i == 0 && j == 0)
-				continue;
-			if (column + j < 0 || column + j >= meshSize.x)
+			searchState.visit(nextIndex, SquareType::QUEUED);
+			if constexpr (Visualise)
 			{
-				continue;
-			}
-			int nextIndex = mapIndex1D(row + i, column + j, meshSize.x);
-			if (cellVec[nextIndex].cellType == SquareType::FINISH)
-			{
-				m_isFound = true;
-				break;
-			}
-			else if (cellVec[nextIndex].cellType == SquareType::EMPTY)
-			{
-				cellVec[nextIndex].cellType = SquareType::QUEUED;
-				cellVec[nextIndex].distance = cellVec[topIndex].distance + cellVec[nextIndex].weight;
-				m_mesh->setCellColor(SquareType::QUEUED, nextIndex);
-
-				m_cellContainer.push({ nextIndex,heuristicFunction(float(column + j), float(row + i), float(finishY),float(finishX),float(cellVec[nextIndex].weight))});
+				if (cellTypes[nextIndex] == SquareType::EMPTY)
+				{
+					m_mesh->setCellColor(SquareType::QUEUED, nextIndex);
+				}
 			}
 		}
-		if (m_isFound)
+		// Relax only cells still waiting in queue and only if new distance is shorter
+		else if (searchState.getState(nextIndex) != SquareType::QUEUED || nextDistance >= searchState.getDistance(nextIndex))
 		{
-			break;
+			continue;
 		}
+		searchState.setDistance(nextIndex, nextDistance);
+		searchState.setParent(nextIndex, direction);
+		float nextEstimate = estimate<Heuristic>(nextIndex, row + DIRECTION_ROW_OFFSET[direction], column + DIRECTION_COL_OFFSET[direction], cellWeights[nextIndex]);
+		// Negated distance breaks ties of equal priority towards cells which are deeper in search
+		m_cellContainer.push(nextIndex, { static_cast<float>(nextDistance) + m_heuristicWeight * nextEstimate, -nextDistance });
+		m_stats.generatedNodes++;
 	}
+	m_stats.peakOpenNodes = std::max(m_stats.peakOpenNodes, m_cellContainer.size());
 	// Mark current Cell as finished
-	if (cellVec[topIndex].cellType != SquareType::START)
-	{
-		cellVec[topIndex].cellType = SquareType::PROCESSED;
-		m_mesh->setCellColor(SquareType::PROCESSED, topIndex);
-	}
-	if (!m_isFound)
+	if (cellTypes[topIndex] != SquareType::START)
 	{
-		if (m_cellContainer.empty())
+		searchState.setState(topIndex, SquareType::PROCESSED);
+		if constexpr (Visualise)
 		{
-			m_isFinished = true;
+			m_mesh->setCellColor(SquareType::PROCESSED, topIndex);
 		}
 	}
-	else
+	if (m_cellContainer.empty())
 	{
-		m_cellContainer = pairPrioQueue();
-		m_cellContainer.push({ topIndex,static_cast<float>(cellVec[topIndex].distance) });
+		m_isFinished = true;
 	}
 }
 
 ////////////////////////////////////////////////////////////
-void AStarSolver::updatePath()
+template<typename Connectivity, typename Cost>
+template<AStarHeuristic Heuristic>
+float AStarSolver<Connectivity, Cost>::estimate(int index, int row, int column, std::uint8_t weight) const
 {
-	sf::Vector2i meshSize = m_mesh->getMeshSize();
-	std::vector<Cell>& cellVec = m_mesh->getSquareVec();
-	auto [topIndex, _] = m_cellContainer.top();
-	m_pathLength++;
-	m_pathWeight += cellVec[topIndex].weight;
-
-	auto [row, column] = mapIndex2D(topIndex, meshSize.x);
-	int minDistance{ std::numeric_limits<int>::max() };
-	int cellIndex{};
-	for (int i = -1; i <= 1; i++)
+	int rows = std::abs(m_finishRow - row);
+	int columns = std::abs(m_finishColumn - column);
+	if constexpr (Heuristic == AStarHeuristic::LANDMARKS)
 	{
-		if (row + i < 0 || row + i >= meshSize.y)
-		{
-			continue;
-		}
-		for (int j = -1; j <= 1; j++)
-		{
-			if (i == 0 && j == 0)
-				continue;
-			if (column + j < 0 || column + j >= meshSize.x)
-			{
-				continue;
-			}
-			int nextIndex = mapIndex1D(row + i, column + j, meshSize.x);
+		return static_cast<float>(m_landmarks->estimate(index));
+	}
+	else if constexpr (Heuristic == AStarHeuristic::MANHATTAN)
+	{
+		return static_cast<float>(ManhattanHeuristic::estimate(rows, columns, m_straightCost, m_diagonalCost));
+	}
+	else if constexpr (Heuristic == AStarHeuristic::CHEBYSHEV)
+	{
+		return static_cast<float>(ChebyshevHeuristic::estimate(rows, columns, m_straightCost, m_diagonalCost));
+	}
+	else if constexpr (Heuristic == AStarHeuristic::OCTILE)
+	{
+		return static_cast<float>(OctileHeuristic::estimate(rows, columns, m_straightCost, m_diagonalCost));
+	}
+	else
+	{
+		return heuristicFunction(float(column), float(row), float(m_finishColumn), float(m_finishRow), float(Cost::getStraightCost(weight)));
+	}
+}
 
-			if ((cellVec[nextIndex].cellType == SquareType::PROCESSED || cellVec[nextIndex].cellType == SquareType::START) && cellVec[nextIndex].distance < minDistance)
-			{
-				cellIndex = nextIndex;
-				minDistance = cellVec[nextIndex].distance;
-			}
-		}
+////////////////////////////////////////////////////////////
+template<typename Connectivity, typename Cost>
+void AStarSolver<Connectivity, Cost>::initialiseSearch()
+{
+	if (m_landmarks)
+	{
+		m_landmarks->update();
+		m_landmarks->setTarget(m_mesh->getFinishPosition());
 	}
-	if (cellVec[topIndex].distance == 0)
+	// Every entered cell weighs at least as much as lightest open cell, so scaled geometric bounds stay admissible
+	std::uint8_t minWeight = m_mesh->getMinCellWeight();
+	m_straightCost = Cost::getStraightCost(minWeight);
+	if constexpr (hasDiagonalMoves<Connectivity>())
 	{
-		m_isFinished = true;
+		m_diagonalCost = Cost::getMoveCost(minWeight, encodeDirection(1, 1));
 	}
 	else
 	{
-		cellVec[topIndex].cellType = SquareType::PATH;
-		m_mesh->setCellColor(SquareType::PATH, topIndex);
-		m_cellContainer.pop();
-		m_cellContainer.push({ cellIndex,float(minDistance) });
+		m_diagonalCost = 2 * m_straightCost;
 	}
+	std::tie(m_finishRow, m_finishColumn) = mapIndex2D(m_mesh->getFinishPosition(), m_mesh->getMeshSize().x);
 }
+
+template class AStarSolver<FourConnectivity, UnitCost>;
+template class AStarSolver<FourConnectivity, WeightCost>;
+template class AStarSolver<FourConnectivity, OctileCost>;
+template class AStarSolver<EightConnectivity, UnitCost>;
+template class AStarSolver<EightConnectivity, WeightCost>;
+template class AStarSolver<EightConnectivity, OctileCost>;
+template class AStarSolver<NoCornerCuttingConnectivity, UnitCost>;
+template class AStarSolver<NoCornerCuttingConnectivity, WeightCost>;
+template class AStarSolver<NoCornerCuttingConnectivity, OctileCost>;
\ No newline at end of file
@@ -1,27 +1,54 @@
 #pragma once
 #include "MeshSolver.h"
-#include <queue>
+#include "LandmarkTable.h"
+#include "SearchPolicies.h"
+#include "src/Utility/IndexedHeap.h"
+#include <memory>
+
+/// <summary>
+/// Estimate of remaining distance used by AStarSolver
+/// </summary>
+enum class AStarHeuristic
+{
+	EUCLIDEAN,	//!< Euclidean distance scaled by weight of entered cell (fast, but not admissible)
+	LANDMARKS,	//!< ALT bound from precomputed landmark distance tables (admissible, accounts for walls)
+	MANHATTAN,	//!< ManhattanHeuristic scaled by lowest cell weight (admissible without diagonal moves)
+	CHEBYSHEV,	//!< ChebyshevHeuristic scaled by lowest cell weight (admissible)
+	OCTILE,		//!< OctileHeuristic scaled by lowest cell weight (admissible, tightest of geometric bounds)
+};
+
+/// <summary>
+/// Node counters of last A* search, used to compare heuristics on a family of meshes
+/// </summary>
+struct AStarStats
+{
+	int expandedNodes{};		//!< Number of cells taken from open list and expanded
+	int generatedNodes{};		//!< Number of cells pushed to open list (one heuristic evaluation each)
+	int peakOpenNodes{};		//!< Largest number of entries in open list
+};
 
 /// <summary>
 /// * A solver that uses the A* algorithm to find the shortest path from a starting point to a destination pointon a Mesh.
+/// Open list is ordered by g + weight * h, ties are broken towards larger g (deeper cells, closer to destination).
+/// With admissible heuristic path cost is at most weight times the optimal one.
+/// Instantiated in AStarSolver.cpp for every pair of policies from SearchPolicies.h.
 /// </summary>
+/// <typeparam name="Connectivity">Moves allowed between cells</typeparam>
+/// <typeparam name="Cost">Cost of moves</typeparam>
+template<typename Connectivity = EightConnectivity, typename Cost = WeightCost>
 class AStarSolver : public MeshSolver
 {
-	/// <summary>
-	/// A functor that compares pairs of integers and floats based on their second element.
-	/// </summary>
-	struct CompareSecond {
-		bool operator()(const std::pair<int, float>& a, const std::pair<int, float>& b) const {
-			return a.second > b.second;
-		}
-	};
-	using pairPrioQueue = std::priority_queue<std::pair<int, float>, std::vector<std::pair<int, float>>, CompareSecond>;
 public:
 	/// <summary>
 	/// Constructs an AStarSolver object that will operate on the given Mesh
 	/// </summary>
 	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
-	AStarSolver(Mesh* mesh);
+	/// <param name="heapMode">How queued cells with shorter distance found are updated</param>
+	/// <param name="heuristic">Estimate of remaining distance (LANDMARKS requires WeightCost)</param>
+	/// <param name="heuristicWeight">Factor of estimate in priority, values above 1 give weighted A*</param>
+	/// <param name="threadCount">Number of threads computing landmark tables</param>
+	AStarSolver(Mesh* mesh, HeapMode heapMode = HeapMode::DECREASE_KEY, AStarHeuristic heuristic = AStarHeuristic::EUCLIDEAN, float heuristicWeight = 1.0f,
+		int threadCount = static_cast<int>(std::thread::hardware_concurrency()));
 	/// <summary>
 	/// Resets the solver to its initial state
 	/// </summary>
@@ -34,8 +61,25 @@ public:
 	/// Returns a string representing the name of the solver.
 	/// </summary>
 	/// <returns></returns>
-	std::string getSolverName() override { return "A* Solver"; }
+	std::string getSolverName() override { return m_solverName; }
+	/// <summary>
+	/// Returns priority queue operation counters of last search.
+	/// </summary>
+	/// <returns>Heap statistics</returns>
+	const HeapStats& getHeapStats() const { return m_cellContainer.getStats(); }
+	/// <summary>
+	/// Returns node counters of last search.
+	/// </summary>
+	/// <returns>Search statistics</returns>
+	const AStarStats& getSearchStats() const { return m_stats; }
+	/// <summary>
+	/// Returns landmark tables used by ALT heuristic.
+	/// </summary>
+	/// <returns>Landmark tables (nullptr for other heuristics)</returns>
+	const LandmarkTable* getLandmarkTable() const { return m_landmarks.get(); }
+	static constexpr float WEIGHTED_HEURISTIC_WEIGHT = 2.0f;	//!< Heuristic weight of weighted A* panel
 private:
+	using Key = std::pair<float, int>;
 	/// <summary>
 	/// Updates the solver by performing one iteration of the A* algorithm.
 	/// This method is called repeatedly until the algorithm finds the destination point or determines that no path exists.
@@ -46,6 +90,52 @@ private:
 	/// This method is called once the destination point has been reached
 	/// </summary>
 	virtual void updatePath() override;
+	/// <summary>
+	/// Runs the A* algorithm until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Runs the A* algorithm with given heuristic until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	/// <typeparam name="Heuristic">Estimate of remaining distance</typeparam>
+	template<AStarHeuristic Heuristic>
+	void runSearch();
+	/// <summary>
+	/// Performs one iteration of the A* algorithm.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	/// <typeparam name="Heuristic">Estimate of remaining distance</typeparam>
+	template<bool Visualise, AStarHeuristic Heuristic>
+	void stepSolver();
+	/// <summary>
+	/// Estimate remaining distance of cell
+	/// </summary>
+	/// <typeparam name="Heuristic">Estimate of remaining distance</typeparam>
+	/// <param name="index">Index of cell</param>
+	/// <param name="row">Row of cell</param>
+	/// <param name="column">Column of cell</param>
+	/// <param name="weight">Weight of cell</param>
+	/// <returns>Estimate (not yet multiplied by heuristic weight)</returns>
+	template<AStarHeuristic Heuristic>
+	float estimate(int index, int row, int column, std::uint8_t weight) const;
+	/// <summary>
+	/// Bring landmark tables and lowest move costs up to date with mesh
+	/// </summary>
+	void initialiseSearch();
 private:
-	pairPrioQueue m_cellContainer;		//!< A priority queue containing cells to be processed by the algorithm.
+	IndexedHeap<Key> m_cellContainer;	//!< A priority queue of cells ordered by estimated path cost, then by larger distance from start
+	std::unique_ptr<LandmarkTable> m_landmarks;	//!< Landmark tables of ALT heuristic (nullptr for other heuristics)
+	AStarHeuristic m_heuristic;			//!< Estimate of remaining distance
+	float m_heuristicWeight;			//!< Factor of estimate in priority
+	std::string m_solverName;			//!< Name including heuristic, weight and policies
+	AStarStats m_stats;					//!< Node counters of last search
+	int m_straightCost{};				//!< Lowest cost of straight move on mesh
+	int m_diagonalCost{};				//!< Lowest cost of moving one cell diagonally on mesh
+	int m_finishRow{};					//!< Row of destination
+	int m_finishColumn{};				//!< Column of destination
+	bool m_isInitialised{ false };		//!< Were landmark tables and move costs brought up to date for current search
 };
\ No newline at end of file
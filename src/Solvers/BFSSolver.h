@@ -1,10 +1,14 @@
 #pragma once
 #include "MeshSolver.h"
+#include "SearchPolicies.h"
 #include <queue>
 
 /// <summary>
 /// A solver that uses the breadth-first search (BFS) algorithm to find the shortest path from a starting point to a destination point on a Mesh.
+/// Moves count as equal, so there is no cost policy. Instantiated in BFSSolver.cpp for every connectivity policy from SearchPolicies.h.
 /// </summary>
+/// <typeparam name="Connectivity">Moves allowed between cells</typeparam>
+template<typename Connectivity = EightConnectivity>
 class BFSSolver : public MeshSolver
 {
 public:
@@ -25,7 +29,7 @@ public:
 	/// Returns a string representing the name of the solver.
 	/// </summary>
 	/// <returns></returns>
-	std::string getSolverName() override { return "BFSSolver"; }
+	std::string getSolverName() override { return getPolicyName<Connectivity>("BFSSolver"); }
 private:
 	/// <summary>
 	/// Updates the solver by performing one iteration of the A* algorithm.
@@ -37,6 +41,20 @@ private:
 	/// This method is called once the destination point has been reached
 	/// </summary>
 	virtual void updatePath() override;
+	/// <summary>
+	/// Runs the BFS algorithm until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Performs one iteration of the BFS algorithm.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepSolver();
 private:
 	std::queue<int> m_cellContainer;	 //!< A queue containing cells to be processed by the algorithm.
 };
\ No newline at end of file
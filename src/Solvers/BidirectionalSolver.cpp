@@ -0,0 +1,287 @@
+#include "BidirectionalSolver.h"
+#include <algorithm>
+#include <cstdlib>
+
+////////////////////////////////////////////////////////////
+BidirectionalSolver::BidirectionalSolver(Mesh* mesh, BidirectionalMode mode) : MeshSolver(mesh), m_mode{ mode }
+{
+	m_backwardState.resize(mesh->getCellCount());
+	m_forwardHeap.resize(mesh->getCellCount());
+	m_backwardHeap.resize(mesh->getCellCount());
+	reset();
+}
+
+////////////////////////////////////////////////////////////
+void BidirectionalSolver::reset()
+{
+	resetStartPosition();
+	resetSolver();
+}
+
+void BidirectionalSolver::resetStartPosition()
+{
+	int startIndex = m_mesh->getStartPosition();
+	int finishIndex = m_mesh->getFinishPosition();
+	m_forwardHeap.clear();
+	m_backwardHeap.clear();
+	m_forwardQueue = std::queue<int>();
+	m_backwardQueue = std::queue<int>();
+	// Backward search starts from destination point at distance 0
+	m_backwardState.newSearch();
+	m_backwardState.visit(finishIndex, SquareType::FINISH);
+	m_backwardState.setDistance(finishIndex, 0);
+	if (m_mode == BidirectionalMode::BFS)
+	{
+		m_forwardQueue.push(startIndex);
+		m_backwardQueue.push(finishIndex);
+	}
+	else
+	{
+		m_forwardHeap.push(startIndex, 0);
+		m_backwardHeap.push(finishIndex, 0);
+	}
+	m_meetIndex = -1;
+	m_bestCost = std::numeric_limits<int>::max();
+}
+
+////////////////////////////////////////////////////////////
+std::string BidirectionalSolver::getSolverName()
+{
+	switch (m_mode)
+	{
+	case BidirectionalMode::BFS:
+		return "Bidirectional BFS Solver";
+	case BidirectionalMode::DJIKSTRA:
+		return "Bidirectional DJIKSTRA Solver";
+	default:
+		return "Bidirectional A* Solver";
+	}
+}
+
+////////////////////////////////////////////////////////////
+void BidirectionalSolver::updateSolver()
+{
+	stepSolver<true>();
+}
+
+////////////////////////////////////////////////////////////
+void BidirectionalSolver::updatePath()
+{
+	stepParentPath<true>();
+}
+
+////////////////////////////////////////////////////////////
+void BidirectionalSolver::runSolver()
+{
+	while (!m_isFound && !m_isFinished)
+	{
+		stepSolver<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void BidirectionalSolver::runPath()
+{
+	while (!m_isFinished)
+	{
+		stepParentPath<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<bool Visualise>
+void BidirectionalSolver::stepSolver()
+{
+	// Frontiers touching is not enough, search stops only once no queued cell can lead to cheaper path
+	if (isFrontierEmpty(false) || isFrontierEmpty(true) || canStop())
+	{
+		if (m_meetIndex == -1)
+		{
+			m_isFinished = true;
+			return;
+		}
+		m_isFound = true;
+		joinPaths();
+		int finishIndex = m_mesh->getFinishPosition();
+		beginPath(getParentIndex(finishIndex, m_mesh->getSearchState().getParent(finishIndex), m_mesh->getMeshSize().x));
+		return;
+	}
+	// Expand smaller frontier to keep both searches balanced
+	if (getFrontierSize(true) < getFrontierSize(false))
+	{
+		expandFrontier<Visualise, true>();
+	}
+	else
+	{
+		expandFrontier<Visualise, false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<bool Visualise, bool Backward>
+void BidirectionalSolver::expandFrontier()
+{
+	sf::Vector2i meshSize = m_mesh->getMeshSize();
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	SearchState& searchState = Backward ? m_backwardState : m_mesh->getSearchState();
+	SearchState& otherState = Backward ? m_mesh->getSearchState() : m_backwardState;
+	IndexedHeap<int>& heap = Backward ? m_backwardHeap : m_forwardHeap;
+	std::queue<int>& queue = Backward ? m_backwardQueue : m_forwardQueue;
+	// Each frontier may enter only empty cells and root of the other one
+	SquareType targetType = Backward ? SquareType::START : SquareType::FINISH;
+	auto [targetRow, targetColumn] = mapIndex2D(Backward ? m_mesh->getStartPosition() : m_mesh->getFinishPosition(), meshSize.x);
+	auto [rootRow, rootColumn] = mapIndex2D(Backward ? m_mesh->getFinishPosition() : m_mesh->getStartPosition(), meshSize.x);
+	int topIndex;
+	if (m_mode == BidirectionalMode::BFS)
+	{
+		topIndex = queue.front();
+		queue.pop();
+	}
+	else
+	{
+		topIndex = heap.pop().first;
+	}
+
+	m_squareProcessed++;
+	int topDistance = searchState.getDistance(topIndex);
+	auto [row, column] = mapIndex2D(topIndex, meshSize.x);
+	for (auto [nextIndex, direction] : m_mesh->getNeighbours(topIndex))
+	{
+		if (cellTypes[nextIndex] != SquareType::EMPTY && cellTypes[nextIndex] != targetType)
+		{
+			continue;
+		}
+		// Backward search walks moves in reverse, so it pays weight of the cell it leaves
+		int nextDistance = topDistance + 1;
+		if (m_mode != BidirectionalMode::BFS)
+		{
+			nextDistance = topDistance + (Backward ? cellWeights[topIndex] : cellWeights[nextIndex]);
+		}
+		bool isImproved = false;
+		if (!searchState.isVisited(nextIndex))
+		{
+			searchState.visit(nextIndex, SquareType::QUEUED);
+			isImproved = true;
+			if constexpr (Visualise)
+			{
+				if (cellTypes[nextIndex] == SquareType::EMPTY && !otherState.isVisited(nextIndex))
+				{
+					m_mesh->setCellColor(Backward ? SquareType::UNFINISHED : SquareType::QUEUED, nextIndex);
+				}
+			}
+		}
+		else if (m_mode != BidirectionalMode::BFS && searchState.getState(nextIndex) == SquareType::QUEUED && nextDistance < searchState.getDistance(nextIndex))
+		{
+			isImproved = true;
+		}
+		if (isImproved)
+		{
+			searchState.setDistance(nextIndex, nextDistance);
+			searchState.setParent(nextIndex, direction);
+			if (m_mode == BidirectionalMode::BFS)
+			{
+				queue.push(nextIndex);
+			}
+			else if (m_mode == BidirectionalMode::DJIKSTRA)
+			{
+				heap.push(nextIndex, nextDistance);
+			}
+			else
+			{
+				// Both frontiers use average of heuristics towards their targets (doubled to stay integer),
+				// so they work on the same consistent reduced costs and Djikstra stopping rule applies
+				int nextRow = row + DIRECTION_ROW_OFFSET[direction];
+				int nextColumn = column + DIRECTION_COL_OFFSET[direction];
+				int targetHeuristic = std::max(std::abs(targetRow - nextRow), std::abs(targetColumn - nextColumn)) * Mesh::MIN_CELL_WEIGHT;
+				int rootHeuristic = std::max(std::abs(rootRow - nextRow), std::abs(rootColumn - nextColumn)) * Mesh::MIN_CELL_WEIGHT;
+				heap.push(nextIndex, 2 * nextDistance + targetHeuristic - rootHeuristic);
+			}
+		}
+		// Frontiers touch, path through this cell is a candidate for best meeting
+		if (otherState.isVisited(nextIndex))
+		{
+			int cost = searchState.getDistance(nextIndex) + otherState.getDistance(nextIndex);
+			if (cost < m_bestCost)
+			{
+				m_bestCost = cost;
+				m_meetIndex = nextIndex;
+			}
+		}
+	}
+	// Mark current Cell as finished
+	if (cellTypes[topIndex] == SquareType::EMPTY)
+	{
+		searchState.setState(topIndex, SquareType::PROCESSED);
+		if constexpr (Visualise)
+		{
+			m_mesh->setCellColor(Backward ? SquareType::PROCESSED2 : SquareType::PROCESSED, topIndex);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool BidirectionalSolver::canStop()
+{
+	if (m_meetIndex == -1)
+	{
+		return false;
+	}
+	// Cheaper path would have to pass cells at least as far as both frontier tops
+	// A* keys of both frontiers on the same cell sum up to doubled path length through it
+	int bound = m_mode == BidirectionalMode::ASTAR ? 2 * m_bestCost : m_bestCost;
+	return getFrontierKey(false) + getFrontierKey(true) >= bound;
+}
+
+////////////////////////////////////////////////////////////
+bool BidirectionalSolver::isFrontierEmpty(bool backward)
+{
+	if (m_mode == BidirectionalMode::BFS)
+	{
+		return backward ? m_backwardQueue.empty() : m_forwardQueue.empty();
+	}
+	return backward ? m_backwardHeap.empty() : m_forwardHeap.empty();
+}
+
+////////////////////////////////////////////////////////////
+int BidirectionalSolver::getFrontierSize(bool backward)
+{
+	if (m_mode == BidirectionalMode::BFS)
+	{
+		return static_cast<int>(backward ? m_backwardQueue.size() : m_forwardQueue.size());
+	}
+	return backward ? m_backwardHeap.size() : m_forwardHeap.size();
+}
+
+////////////////////////////////////////////////////////////
+int BidirectionalSolver::getFrontierKey(bool backward)
+{
+	if (m_mode == BidirectionalMode::BFS)
+	{
+		return backward ? m_backwardState.getDistance(m_backwardQueue.front()) : m_mesh->getSearchState().getDistance(m_forwardQueue.front());
+	}
+	return backward ? m_backwardHeap.top().second : m_forwardHeap.top().second;
+}
+
+////////////////////////////////////////////////////////////
+void BidirectionalSolver::joinPaths()
+{
+	int width = m_mesh->getMeshSize().x;
+	int finishIndex = m_mesh->getFinishPosition();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	SearchState& searchState = m_mesh->getSearchState();
+	int index = m_meetIndex;
+	while (index != finishIndex)
+	{
+		// Backward parent points from cell towards destination, forward parent of that cell is the opposite move
+		std::uint8_t backwardDirection = m_backwardState.getParent(index);
+		int nextIndex = getParentIndex(index, backwardDirection, width);
+		if (!searchState.isVisited(nextIndex))
+		{
+			searchState.visit(nextIndex, SquareType::QUEUED);
+		}
+		searchState.setDistance(nextIndex, searchState.getDistance(index) + (m_mode == BidirectionalMode::BFS ? 1 : cellWeights[nextIndex]));
+		searchState.setParent(nextIndex, static_cast<std::uint8_t>(8 - backwardDirection));
+		index = nextIndex;
+	}
+}
\ No newline at end of file
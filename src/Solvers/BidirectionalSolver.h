@@ -0,0 +1,111 @@
+#pragma once
+#include "MeshSolver.h"
+#include "src/Utility/IndexedHeap.h"
+#include <limits>
+#include <queue>
+
+/// <summary>
+/// Algorithm used by both frontiers of BidirectionalSolver
+/// </summary>
+enum class BidirectionalMode
+{
+	BFS,		//!< Breadth-first search (fewest moves)
+	DJIKSTRA,	//!< Djikstra algorithm
+	ASTAR,		//!< A* algorithm with averaged Chebyshev heuristics of both directions
+};
+
+/// <summary>
+/// A solver that grows one frontier from the starting point and another from the destination point until best meeting cell is proven.
+/// Backward frontier keeps its own search state, cells reached by it are coloured as UNFINISHED/PROCESSED2.
+/// </summary>
+class BidirectionalSolver : public MeshSolver
+{
+public:
+	/// <summary>
+	/// Constructs an BidirectionalSolver object that will operate on the given Mesh
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	/// <param name="mode">Algorithm used by both frontiers</param>
+	BidirectionalSolver(Mesh* mesh, BidirectionalMode mode);
+	/// <summary>
+	/// Resets the solver to its initial state
+	/// </summary>
+	void reset() override;
+	/// <summary>
+	/// Reset starting position of solver;
+	/// </summary>
+	void resetStartPosition() override;
+	/// <summary>
+	/// Returns a string representing the name of the solver.
+	/// </summary>
+	/// <returns></returns>
+	std::string getSolverName() override;
+private:
+	/// <summary>
+	/// Updates the solver by expanding one cell of smaller frontier.
+	/// This method is called repeatedly until the algorithm finds the destination point or determines that no path exists.
+	/// </summary>
+	virtual void updateSolver() override;
+	/// <summary>
+	/// Updates the path after the algorithm has finished.
+	/// This method is called once the destination point has been reached
+	/// </summary>
+	virtual void updatePath() override;
+	/// <summary>
+	/// Runs the bidirectional search until best meeting cell is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Check stopping rule and expand one cell of smaller frontier.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepSolver();
+	/// <summary>
+	/// Expand top cell of one frontier.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	/// <typeparam name="Backward">Whether frontier grows from destination point</typeparam>
+	template<bool Visualise, bool Backward>
+	void expandFrontier();
+	/// <summary>
+	/// Check if no cell on frontier can improve best meeting anymore
+	/// </summary>
+	/// <returns>True if search can stop</returns>
+	bool canStop();
+	/// <summary>
+	/// Check if frontier has no cells left
+	/// </summary>
+	/// <param name="backward">Whether frontier grows from destination point</param>
+	/// <returns>True if frontier is empty</returns>
+	bool isFrontierEmpty(bool backward);
+	/// <summary>
+	/// Get number of cells waiting in frontier
+	/// </summary>
+	/// <param name="backward">Whether frontier grows from destination point</param>
+	/// <returns>Frontier size</returns>
+	int getFrontierSize(bool backward);
+	/// <summary>
+	/// Get lowest key of frontier (frontier must not be empty)
+	/// </summary>
+	/// <param name="backward">Whether frontier grows from destination point</param>
+	/// <returns>Distance (BFS, Djikstra) or doubled reduced distance (A*) of top cell</returns>
+	int getFrontierKey(bool backward);
+	/// <summary>
+	/// Copy backward parents from meeting cell to destination into forward search state, so path can be rebuilt from destination
+	/// </summary>
+	void joinPaths();
+private:
+	BidirectionalMode m_mode;				//!< Algorithm used by both frontiers
+	SearchState m_backwardState;			//!< Search state of frontier growing from destination point
+	IndexedHeap<int> m_forwardHeap;			//!< Priority queue of forward frontier (Djikstra, A*)
+	IndexedHeap<int> m_backwardHeap;		//!< Priority queue of backward frontier (Djikstra, A*)
+	std::queue<int> m_forwardQueue;			//!< Queue of forward frontier (BFS)
+	std::queue<int> m_backwardQueue;		//!< Queue of backward frontier (BFS)
+	int m_meetIndex{ -1 };					//!< Cell where best path found so far joins both frontiers
+	int m_bestCost{ std::numeric_limits<int>::max() };	//!< Cost of best path found so far
+};
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "BitBFSSolver.h"
+#include <utility>
+
+////////////////////////////////////////////////////////////
+BitBFSSolver::BitBFSSolver(Mesh* mesh, bool recordDistances) : MeshSolver(mesh), m_recordDistances{ recordDistances }
+{
+	sf::Vector2i meshSize = mesh->getMeshSize();
+	m_free.resize(meshSize.x, meshSize.y);
+	m_visited.resize(meshSize.x, meshSize.y);
+	m_frontier.resize(meshSize.x, meshSize.y);
+	m_next.resize(meshSize.x, meshSize.y);
+	m_residues[0].resize(meshSize.x, meshSize.y);
+	m_residues[1].resize(meshSize.x, meshSize.y);
+	reset();
+}
+
+////////////////////////////////////////////////////////////
+void BitBFSSolver::reset()
+{
+	resetStartPosition();
+	resetSolver();
+}
+
+void BitBFSSolver::resetStartPosition()
+{
+	m_level = 0;
+}
+
+////////////////////////////////////////////////////////////
+void BitBFSSolver::updateSolver()
+{
+	stepSolver<true>();
+}
+
+////////////////////////////////////////////////////////////
+void BitBFSSolver::updatePath()
+{
+	stepParentPath<true>();
+}
+
+////////////////////////////////////////////////////////////
+void BitBFSSolver::runSolver()
+{
+	while (!m_isFound && !m_isFinished)
+	{
+		stepSolver<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void BitBFSSolver::runPath()
+{
+	while (!m_isFinished)
+	{
+		stepParentPath<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<bool Visualise>
+void BitBFSSolver::stepSolver()
+{
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	SearchState& searchState = m_mesh->getSearchState();
+	if (m_level == 0)
+	{
+		// Grids are rebuilt for each search, so walls placed since last one are taken into account
+		m_free.assign([&](int index) { return cellTypes[index] == SquareType::EMPTY || cellTypes[index] == SquareType::FINISH; });
+		m_visited.clear();
+		m_frontier.clear();
+		m_residues[0].clear();
+		m_residues[1].clear();
+		m_visited.set(m_mesh->getStartPosition());
+		m_frontier.set(m_mesh->getStartPosition());
+	}
+	bool isExpanded = BitGrid::expand(m_frontier, m_free, m_visited, m_next);
+	m_squareProcessed += m_frontier.count();
+	if constexpr (Visualise)
+	{
+		m_frontier.forEach([&](int index)
+			{
+				if (cellTypes[index] != SquareType::START)
+				{
+					searchState.setState(index, SquareType::PROCESSED);
+					m_mesh->setCellColor(SquareType::PROCESSED, index);
+				}
+			});
+	}
+	m_level++;
+	if (m_level % 3)
+	{
+		m_residues[m_level % 3 - 1].unite(m_next);
+	}
+	if (Visualise || m_recordDistances)
+	{
+		m_next.forEach([&](int index)
+			{
+				searchState.visit(index, SquareType::QUEUED);
+				searchState.setDistance(index, m_level);
+				if constexpr (Visualise)
+				{
+					if (cellTypes[index] == SquareType::EMPTY)
+					{
+						m_mesh->setCellColor(SquareType::QUEUED, index);
+					}
+				}
+			});
+	}
+	std::swap(m_frontier, m_next);
+	if (m_frontier.test(m_mesh->getFinishPosition()))
+	{
+		int finishIndex = m_mesh->getFinishPosition();
+		m_isFound = true;
+		assignParents();
+		beginPath(getParentIndex(finishIndex, searchState.getParent(finishIndex), m_mesh->getMeshSize().x));
+		return;
+	}
+	if (!isExpanded)
+	{
+		m_isFinished = true;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void BitBFSSolver::assignParents()
+{
+	SearchState& searchState = m_mesh->getSearchState();
+	int index = m_mesh->getFinishPosition();
+	int distance = m_level;
+	searchState.visit(index, SquareType::QUEUED);
+	searchState.setDistance(index, distance);
+	while (distance > 0)
+	{
+		// Any reached neighbour from previous wave is a valid parent, all of them lie on some shortest path
+		int parentResidue = (distance - 1) % 3;
+		for (auto [neighbourIndex, direction] : m_mesh->getNeighbours(index))
+		{
+			if (m_visited.test(neighbourIndex) && getResidue(neighbourIndex) == parentResidue)
+			{
+				// Cell is entered by reversed move from its parent
+				searchState.setParent(index, 8 - direction);
+				index = neighbourIndex;
+				break;
+			}
+		}
+		distance--;
+		// Starting point already holds distance 0
+		if (distance > 0)
+		{
+			searchState.visit(index, SquareType::PROCESSED);
+			searchState.setDistance(index, distance);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+#include "MeshSolver.h"
+#include "src/Utility/BitGrid.h"
+
+/// <summary>
+/// A solver that uses bit-parallel breadth-first search to find the shortest path from a starting point to a destination point on a Mesh.
+/// Free cells and frontier are kept as bit grids, each step grows the whole frontier by one wave with word-wide shifts and masks.
+/// Each wave is also merged into bit planes of distance modulo 3, which is enough to pick parents along the path once destination is reached
+/// (distances of neighbouring cells differ by at most 1), so per-cell distances are written only on demand.
+/// </summary>
+class BitBFSSolver : public MeshSolver
+{
+public:
+	/// <summary>
+	/// Constructs an BitBFSSolver object that will operate on the given Mesh
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	/// <param name="recordDistances">Whether distance of every reached cell is stored in search state (always done when visualising)</param>
+	BitBFSSolver(Mesh* mesh, bool recordDistances = false);
+	/// <summary>
+	/// Resets the solver to its initial state
+	/// </summary>
+	void reset() override;
+	/// <summary>
+	/// Reset starting position of solver;
+	/// </summary>
+	void resetStartPosition() override;
+	/// <summary>
+	/// Returns a string representing the name of the solver.
+	/// </summary>
+	/// <returns></returns>
+	std::string getSolverName() override { return "BIT BFS Solver"; }
+	/// <summary>
+	/// Get cells reached by last search (whole reachable area if search finished without path)
+	/// </summary>
+	/// <returns>Bit grid of reached cells</returns>
+	const BitGrid& getReached() const { return m_visited; }
+private:
+	/// <summary>
+	/// Updates the solver by expanding frontier by one wave.
+	/// This method is called repeatedly until the algorithm finds the destination point or determines that no path exists.
+	/// </summary>
+	virtual void updateSolver() override;
+	/// <summary>
+	/// Updates the path after the algorithm has finished.
+	/// This method is called once the destination point has been reached
+	/// </summary>
+	virtual void updatePath() override;
+	/// <summary>
+	/// Runs the bit-parallel BFS until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Expands frontier by one wave.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepSolver();
+	/// <summary>
+	/// Walk back from destination through cells of decreasing distance and store distance and parent of each of them
+	/// </summary>
+	void assignParents();
+	/// <summary>
+	/// Get distance of reached cell modulo 3
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Distance modulo 3</returns>
+	int getResidue(int index) const { return m_residues[0].test(index) ? 1 : m_residues[1].test(index) ? 2 : 0; }
+private:
+	BitGrid m_free;			//!< Cells which can be entered
+	BitGrid m_visited;		//!< Cells reached so far
+	BitGrid m_frontier;		//!< Cells of current wave
+	BitGrid m_next;			//!< Cells of next wave
+	BitGrid m_residues[2];	//!< Cells with distance 1 and 2 modulo 3
+	bool m_recordDistances;	//!< Store distance of every reached cell
+	int m_level{};			//!< Distance of current wave from start
+};
\ No newline at end of file
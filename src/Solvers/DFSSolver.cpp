@@ -2,77 +2,103 @@
 #include <random>
 
 ////////////////////////////////////////////////////////////
-DFSSolver::DFSSolver(Mesh* mesh) : MeshSolver(mesh)
+template<typename Connectivity>
+DFSSolver<Connectivity>::DFSSolver(Mesh* mesh) : MeshSolver(mesh)
 {
 	reset();
 }
 
 ////////////////////////////////////////////////////////////
-void DFSSolver::reset()
+template<typename Connectivity>
+void DFSSolver<Connectivity>::reset()
 {
 	resetStartPosition();
 	resetSolver();
 }
 
-void DFSSolver::resetStartPosition()
+template<typename Connectivity>
+void DFSSolver<Connectivity>::resetStartPosition()
 {
 	m_cellContainer = std::stack<int>();
 	m_cellContainer.push(m_mesh->getStartPosition());
 }
 
 ////////////////////////////////////////////////////////////
-void DFSSolver::updateSolver()
+template<typename Connectivity>
+void DFSSolver<Connectivity>::updateSolver()
 {
-	sf::Vector2i meshSize = m_mesh->getMeshSize();
-	std::vector<Cell>& cellVec = m_mesh->getSquareVec();
+	stepSolver<true>();
+}
+
+////////////////////////////////////////////////////////////
+template<typename Connectivity>
+void DFSSolver<Connectivity>::updatePath()
+{
+	stepPath<true>();
+}
+
+////////////////////////////////////////////////////////////
+template<typename Connectivity>
+void DFSSolver<Connectivity>::runSolver()
+{
+	while (!m_isFound && !m_isFinished)
+	{
+		stepSolver<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<typename Connectivity>
+void DFSSolver<Connectivity>::runPath()
+{
+	while (!m_isFinished)
+	{
+		stepPath<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<typename Connectivity>
+template<bool Visualise>
+void DFSSolver<Connectivity>::stepSolver()
+{
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	SearchState& searchState = m_mesh->getSearchState();
 	int topIndex = m_cellContainer.top();
 
 	// Mark current cell
-	if (cellVec[topIndex].cellType != SquareType::START)
+	if (cellTypes[topIndex] != SquareType::START)
 	{
-		cellVec[topIndex].cellType = SquareType::UNFINISHED;
-		m_mesh->setCellColor(SquareType::UNFINISHED, topIndex);
+		searchState.setState(topIndex, SquareType::UNFINISHED);
+		if constexpr (Visualise)
+		{
+			m_mesh->setCellColor(SquareType::UNFINISHED, topIndex);
+		}
 	}
 	std::vector<int> availableCells;
 
-	auto [row, column] = mapIndex2D(topIndex, meshSize.x);
-	for (int i = -1; i <= 1; i++)
+	for (auto [nextIndex, direction] : m_mesh->getNeighbours<Connectivity>(topIndex))
 	{
-		if (row + i < 0 || row + i >= meshSize.y)
+		if (cellTypes[nextIndex] == SquareType::FINISH)
 		{
-			continue;
-		}
-		for (int j = -1; j <= 1; j++)
-		{
-			if (i == 0 && j == 0)
-				continue;
-			if (column + j < 0 || column + j >= meshSize.x)
-			{
-				continue;
-			}
-			int nextIndex = mapIndex1D(row + i, column + j, meshSize.x);
-			if (cellVec[nextIndex].cellType == SquareType::FINISH)
-			{
-				m_isFound = true;
-				break;
-			}
-			else if (cellVec[nextIndex].cellType == SquareType::EMPTY)
-			{
-				availableCells.push_back(nextIndex);
-			}
+			m_isFound = true;
+			break;
 		}
-		if (m_isFound)
+		else if (cellTypes[nextIndex] == SquareType::EMPTY && !searchState.isVisited(nextIndex))
 		{
-			break;
+			availableCells.push_back(nextIndex);
 		}
 	}
 	if (availableCells.empty())
 	{
 		m_squareProcessed++;
-		if (cellVec[topIndex].cellType != SquareType::START)
+		if (cellTypes[topIndex] != SquareType::START)
 		{
-			cellVec[topIndex].cellType = SquareType::PROCESSED;
-			m_mesh->setCellColor(SquareType::PROCESSED, topIndex);
+			searchState.setState(topIndex, SquareType::PROCESSED);
+			if constexpr (Visualise)
+			{
+				m_mesh->setCellColor(SquareType::PROCESSED, topIndex);
+			}
 		}
 		m_cellContainer.pop();
 		if (m_cellContainer.empty())
@@ -88,29 +114,43 @@ void DFSSolver::updateSolver()
 		std::shuffle(availableCells.begin(), availableCells.end(), gen);
 		for (auto val : availableCells)
 		{
-			cellVec[val].cellType = SquareType::QUEUED;
-			m_mesh->setCellColor(SquareType::QUEUED, val);
+			searchState.visit(val, SquareType::QUEUED);
+			if constexpr (Visualise)
+			{
+				m_mesh->setCellColor(SquareType::QUEUED, val);
+			}
 			m_cellContainer.push(val);
 		}
 	}
 }
 
 ////////////////////////////////////////////////////////////
-void DFSSolver::updatePath()
+template<typename Connectivity>
+template<bool Visualise>
+void DFSSolver<Connectivity>::stepPath()
 {
-	std::vector<Cell>& cellVec = m_mesh->getSquareVec();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	SearchState& searchState = m_mesh->getSearchState();
 	int topIndex = m_cellContainer.top();
 
-	if (cellVec[topIndex].cellType == SquareType::UNFINISHED)
+	if (searchState.getState(topIndex) == SquareType::UNFINISHED)
 	{
-		cellVec[topIndex].cellType = SquareType::PATH;
-		m_mesh->setCellColor(SquareType::PATH, topIndex);
+		searchState.setState(topIndex, SquareType::PATH);
+		m_path.push_back(topIndex);
+		if constexpr (Visualise)
+		{
+			m_mesh->setCellColor(SquareType::PATH, topIndex);
+		}
 		m_pathLength++;
-		m_pathWeight += cellVec[topIndex].weight;
+		m_pathWeight += cellWeights[topIndex];
 	}
 	m_cellContainer.pop();
-	if (m_cellContainer.size() == 1)
+	if (m_cellContainer.size() <= 1)
 	{
 		m_isFinished = true;
 	}
 }
+
+template class DFSSolver<FourConnectivity>;
+template class DFSSolver<EightConnectivity>;
+template class DFSSolver<NoCornerCuttingConnectivity>;
@@ -1,10 +1,14 @@
 #pragma once
 #include "MeshSolver.h"
+#include "SearchPolicies.h"
 #include <stack>
 
 /// <summary>
 /// A solver that uses the depth-first search (DFS) algorithm to find a path from a starting point to a destination point on a Mesh.
+/// Search order ignores move cost, so there is no cost policy. Instantiated in DFSSolver.cpp for every connectivity policy from SearchPolicies.h.
 /// </summary>
+/// <typeparam name="Connectivity">Moves allowed between cells</typeparam>
+template<typename Connectivity = EightConnectivity>
 class DFSSolver : public MeshSolver
 {
 public:
@@ -25,7 +29,7 @@ public:
 	/// Returns a string representing the name of the solver.
 	/// </summary>
 	/// <returns></returns>
-	std::string getSolverName() override { return "DFSSolver"; }
+	std::string getSolverName() override { return getPolicyName<Connectivity>("DFSSolver"); }
 private:
 	/// <summary>
 	/// Updates the solver by performing one iteration of the A* algorithm.
@@ -37,6 +41,26 @@ private:
 	/// This method is called once the destination point has been reached
 	/// </summary>
 	virtual void updatePath() override;
+	/// <summary>
+	/// Runs the DFS algorithm until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Performs one iteration of the DFS algorithm.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepSolver();
+	/// <summary>
+	/// Performs one step of path reconstruction.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether path cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepPath();
 private:
 	std::stack<int> m_cellContainer;	//!< A stack containing cells to be processed by the algorithm.
 };
\ No newline at end of file
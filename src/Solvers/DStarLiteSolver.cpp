@@ -0,0 +1,248 @@
+#include "DStarLiteSolver.h"
+#include <algorithm>
+#include <cstdlib>
+
+////////////////////////////////////////////////////////////
+DStarLiteSolver::DStarLiteSolver(Mesh* mesh) : MeshSolver(mesh)
+{
+	m_cellContainer.resize(mesh->getCellCount());
+	m_distances.resize(mesh->getCellCount());
+	m_lookahead.resize(mesh->getCellCount());
+	reset();
+}
+
+////////////////////////////////////////////////////////////
+void DStarLiteSolver::reset()
+{
+	resetStartPosition();
+	resetSolver();
+}
+
+void DStarLiteSolver::resetStartPosition()
+{
+	// Search values are repaired lazily at first step, so edits between searches cost nothing until next search
+	m_isInitialised = false;
+}
+
+////////////////////////////////////////////////////////////
+void DStarLiteSolver::updateSolver()
+{
+	stepSolver<true>();
+}
+
+////////////////////////////////////////////////////////////
+void DStarLiteSolver::updatePath()
+{
+	stepParentPath<true>();
+}
+
+////////////////////////////////////////////////////////////
+void DStarLiteSolver::runSolver()
+{
+	while (!m_isFound && !m_isFinished)
+	{
+		stepSolver<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void DStarLiteSolver::runPath()
+{
+	while (!m_isFinished)
+	{
+		stepParentPath<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<bool Visualise>
+void DStarLiteSolver::stepSolver()
+{
+	if (!m_isInitialised)
+	{
+		initialiseSearch();
+		m_isInitialised = true;
+	}
+	int startIndex = m_mesh->getStartPosition();
+	// Search ends once start is consistent and no queued vertex can still lower its distance
+	if (m_cellContainer.empty() || (!(m_cellContainer.top().second < calculateKey(startIndex)) && m_lookahead[startIndex] <= m_distances[startIndex]))
+	{
+		if (m_lookahead[startIndex] >= INFINITE_DISTANCE)
+		{
+			m_isFinished = true;
+		}
+		else
+		{
+			m_isFound = true;
+			extractPath();
+		}
+		return;
+	}
+	auto [topIndex, topKey] = m_cellContainer.top();
+	Key currentKey = calculateKey(topIndex);
+	if (topKey < currentKey)
+	{
+		// Key was computed for earlier start position
+		m_cellContainer.update(topIndex, currentKey);
+		return;
+	}
+	m_cellContainer.pop();
+	m_squareProcessed++;
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	if (m_distances[topIndex] > m_lookahead[topIndex])
+	{
+		// Overconsistent vertex: distance drops and can only lower lookahead of its predecessors
+		m_distances[topIndex] = m_lookahead[topIndex];
+		if (isEnterable(topIndex))
+		{
+			int distance = m_distances[topIndex] + cellWeights[topIndex];
+			for (auto [nextIndex, direction] : m_mesh->getNeighbours(topIndex))
+			{
+				if (nextIndex != m_goal && distance < m_lookahead[nextIndex])
+				{
+					m_lookahead[nextIndex] = distance;
+					queueVertex(nextIndex);
+				}
+			}
+		}
+	}
+	else
+	{
+		// Underconsistent vertex: distance is raised and predecessors which relied on it look for another successor
+		m_distances[topIndex] = INFINITE_DISTANCE;
+		updateVertex(topIndex);
+		for (auto [nextIndex, direction] : m_mesh->getNeighbours(topIndex))
+		{
+			updateVertex(nextIndex);
+		}
+	}
+	if constexpr (Visualise)
+	{
+		if (m_mesh->getCellTypes()[topIndex] == SquareType::EMPTY)
+		{
+			m_mesh->setCellColor(SquareType::PROCESSED, topIndex);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void DStarLiteSolver::initialiseSearch()
+{
+	int startIndex = m_mesh->getStartPosition();
+	int finishIndex = m_mesh->getFinishPosition();
+	if (!m_isBuilt || finishIndex != m_goal || !m_mesh->getEditedCells(m_revision, m_editedCells))
+	{
+		std::fill(m_distances.begin(), m_distances.end(), INFINITE_DISTANCE);
+		std::fill(m_lookahead.begin(), m_lookahead.end(), INFINITE_DISTANCE);
+		m_cellContainer.clear();
+		m_keyModifier = 0;
+		m_goal = finishIndex;
+		m_lookahead[m_goal] = 0;
+		m_cellContainer.push(m_goal, calculateKey(m_goal));
+		m_isBuilt = true;
+	}
+	else
+	{
+		// Keys already queued stay valid lower bounds when they are raised by distance start moved
+		m_keyModifier += heuristic(m_lastStart, startIndex);
+		// Edited cell changes cost of every move into it, so its predecessors are repaired too
+		for (int index : m_editedCells)
+		{
+			updateVertex(index);
+			for (auto [nextIndex, direction] : m_mesh->getNeighbours(index))
+			{
+				updateVertex(nextIndex);
+			}
+		}
+	}
+	m_lastStart = startIndex;
+	m_revision = m_mesh->getRevision();
+}
+
+////////////////////////////////////////////////////////////
+void DStarLiteSolver::updateVertex(int index)
+{
+	if (index != m_goal)
+	{
+		const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+		int lookahead = INFINITE_DISTANCE;
+		if (m_mesh->getCellTypes()[index] != SquareType::FULL)
+		{
+			for (auto [nextIndex, direction] : m_mesh->getNeighbours(index))
+			{
+				if (isEnterable(nextIndex) && m_distances[nextIndex] < INFINITE_DISTANCE)
+				{
+					lookahead = std::min(lookahead, m_distances[nextIndex] + cellWeights[nextIndex]);
+				}
+			}
+		}
+		m_lookahead[index] = lookahead;
+	}
+	queueVertex(index);
+}
+
+////////////////////////////////////////////////////////////
+void DStarLiteSolver::queueVertex(int index)
+{
+	if (m_distances[index] != m_lookahead[index])
+	{
+		m_cellContainer.update(index, calculateKey(index));
+	}
+	else
+	{
+		m_cellContainer.remove(index);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void DStarLiteSolver::extractPath()
+{
+	sf::Vector2i meshSize = m_mesh->getMeshSize();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	SearchState& searchState = m_mesh->getSearchState();
+	int index = m_mesh->getStartPosition();
+	int distance = 0;
+	// Distances strictly decrease along successors with lowest cost, so walk always reaches destination
+	while (index != m_goal)
+	{
+		int bestIndex = -1;
+		std::uint8_t bestDirection = 0;
+		int bestCost = INFINITE_DISTANCE;
+		for (auto [nextIndex, direction] : m_mesh->getNeighbours(index))
+		{
+			if (isEnterable(nextIndex) && m_distances[nextIndex] < INFINITE_DISTANCE && m_distances[nextIndex] + cellWeights[nextIndex] < bestCost)
+			{
+				bestCost = m_distances[nextIndex] + cellWeights[nextIndex];
+				bestIndex = nextIndex;
+				bestDirection = direction;
+			}
+		}
+		distance += cellWeights[bestIndex];
+		searchState.visit(bestIndex, SquareType::PROCESSED);
+		searchState.setDistance(bestIndex, distance);
+		searchState.setParent(bestIndex, bestDirection);
+		index = bestIndex;
+	}
+	beginPath(getParentIndex(m_goal, searchState.getParent(m_goal), meshSize.x));
+}
+
+////////////////////////////////////////////////////////////
+DStarLiteSolver::Key DStarLiteSolver::calculateKey(int index) const
+{
+	int distance = std::min(m_distances[index], m_lookahead[index]);
+	if (distance >= INFINITE_DISTANCE)
+	{
+		return { INFINITE_DISTANCE, INFINITE_DISTANCE };
+	}
+	return { distance + heuristic(m_mesh->getStartPosition(), index) + m_keyModifier, distance };
+}
+
+////////////////////////////////////////////////////////////
+int DStarLiteSolver::heuristic(int from, int to) const
+{
+	// Every step costs at least MIN_CELL_WEIGHT and moves by one cell in Chebyshev metric, so estimate is consistent
+	int meshWidth = m_mesh->getMeshSize().x;
+	auto [fromRow, fromColumn] = mapIndex2D(from, meshWidth);
+	auto [toRow, toColumn] = mapIndex2D(to, meshWidth);
+	return std::max(std::abs(toRow - fromRow), std::abs(toColumn - fromColumn)) * Mesh::MIN_CELL_WEIGHT;
+}
\ No newline at end of file
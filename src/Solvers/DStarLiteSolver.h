@@ -0,0 +1,112 @@
+#pragma once
+#include "MeshSolver.h"
+#include "src/Utility/IndexedHeap.h"
+#include <limits>
+
+/// <summary>
+/// A solver that uses the D* Lite algorithm to find the shortest path from a starting point to a destination point on a Mesh.
+/// Search runs from destination towards start and its g and rhs values are kept between searches,
+/// so after cells are edited or start moves only vertices affected by the change are processed again.
+/// Moving destination or replacing whole mesh starts search from scratch.
+/// </summary>
+class DStarLiteSolver : public MeshSolver
+{
+public:
+	/// <summary>
+	/// Constructs an DStarLiteSolver object that will operate on the given Mesh
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	DStarLiteSolver(Mesh* mesh);
+	/// <summary>
+	/// Resets the solver to its initial state (search values are kept and repaired at next search)
+	/// </summary>
+	void reset() override;
+	/// <summary>
+	/// Reset starting position of solver;
+	/// </summary>
+	void resetStartPosition() override;
+	/// <summary>
+	/// Returns a string representing the name of the solver.
+	/// </summary>
+	/// <returns></returns>
+	std::string getSolverName() override { return "D* Lite Solver"; }
+private:
+	using Key = std::pair<int, int>;
+	/// <summary>
+	/// Updates the solver by processing one vertex of D* Lite.
+	/// This method is called repeatedly until the algorithm finds the destination point or determines that no path exists.
+	/// </summary>
+	virtual void updateSolver() override;
+	/// <summary>
+	/// Updates the path after the algorithm has finished.
+	/// This method is called once the destination point has been reached
+	/// </summary>
+	virtual void updatePath() override;
+	/// <summary>
+	/// Runs the D* Lite algorithm until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Processes one vertex of D* Lite.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepSolver();
+	/// <summary>
+	/// Start from scratch or repair vertices affected by edits and start movement since last search
+	/// </summary>
+	void initialiseSearch();
+	/// <summary>
+	/// Recompute rhs of vertex and requeue it if it is inconsistent
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	void updateVertex(int index);
+	/// <summary>
+	/// Queue inconsistent vertex with its current key, or remove consistent one from queue
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	void queueVertex(int index);
+	/// <summary>
+	/// Follow successors with lowest cost from start and store path in search state
+	/// </summary>
+	void extractPath();
+	/// <summary>
+	/// Get priority of vertex
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Estimated length of path through vertex and its distance to destination</returns>
+	Key calculateKey(int index) const;
+	/// <summary>
+	/// Get lower bound of distance between cells
+	/// </summary>
+	/// <param name="from">Index of first cell</param>
+	/// <param name="to">Index of second cell</param>
+	/// <returns>Chebyshev distance multiplied by lowest cell weight</returns>
+	int heuristic(int from, int to) const;
+	/// <summary>
+	/// Check if cell can be entered by path
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>True if cell is empty or destination</returns>
+	bool isEnterable(int index) const
+	{
+		SquareType type = m_mesh->getCellTypes()[index];
+		return type == SquareType::EMPTY || type == SquareType::FINISH;
+	}
+private:
+	static constexpr int INFINITE_DISTANCE = std::numeric_limits<int>::max() / 2;	//!< Distance of vertex without path to destination
+	IndexedHeap<Key> m_cellContainer;	//!< A priority queue of inconsistent vertices
+	std::vector<int> m_distances;		//!< Distance of each cell to destination (g)
+	std::vector<int> m_lookahead;		//!< One step lookahead distance of each cell to destination (rhs)
+	std::vector<int> m_editedCells;		//!< Cells edited since last search
+	int m_keyModifier{};				//!< Sum of heuristic distances start moved by since search values were created (km)
+	int m_lastStart{};					//!< Start position of last search
+	int m_goal{};						//!< Destination for which search values were created
+	std::uint32_t m_revision{};			//!< Mesh revision of last search
+	bool m_isBuilt{ false };			//!< Are search values valid for mesh revision
+	bool m_isInitialised{ false };		//!< Were search values repaired for current search
+};
\ No newline at end of file
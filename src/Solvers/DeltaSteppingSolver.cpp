@@ -0,0 +1,262 @@
+#include "DeltaSteppingSolver.h"
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+DeltaSteppingSolver::DeltaSteppingSolver(Mesh* mesh, int delta, int threadCount)
+	: MeshSolver(mesh), m_threadPool(threadCount), m_delta{ std::max(1, delta) }
+{
+	// Move from bucket b reaches at most bucket b + 1 + (MAX_CELL_WEIGHT - 1) / delta, so older slots can be reused
+	m_slotCount = Mesh::MAX_CELL_WEIGHT / m_delta + 2;
+	m_tentative = std::make_unique<std::atomic<std::uint64_t>[]>(mesh->getCellCount());
+	m_relaxedDistance = std::make_unique<std::atomic<int>[]>(mesh->getCellCount());
+	m_localBuckets.assign(m_threadPool.getThreadCount(), std::vector<std::vector<int>>(m_slotCount));
+	m_localSettled.resize(m_threadPool.getThreadCount());
+	reset();
+}
+
+////////////////////////////////////////////////////////////
+void DeltaSteppingSolver::reset()
+{
+	resetStartPosition();
+	resetSolver();
+}
+
+void DeltaSteppingSolver::resetStartPosition()
+{
+	for (auto& buckets : m_localBuckets)
+	{
+		for (auto& bucket : buckets)
+		{
+			bucket.clear();
+		}
+	}
+	m_frontier.clear();
+	m_bucket = -1;
+	m_lightRounds = 0;
+}
+
+////////////////////////////////////////////////////////////
+void DeltaSteppingSolver::updateSolver()
+{
+	stepSolver<true>();
+}
+
+////////////////////////////////////////////////////////////
+void DeltaSteppingSolver::updatePath()
+{
+	stepParentPath<true>();
+}
+
+////////////////////////////////////////////////////////////
+void DeltaSteppingSolver::runSolver()
+{
+	while (!m_isFound && !m_isFinished)
+	{
+		stepSolver<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void DeltaSteppingSolver::runPath()
+{
+	while (!m_isFinished)
+	{
+		stepParentPath<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<bool Visualise>
+void DeltaSteppingSolver::stepSolver()
+{
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	SearchState& searchState = m_mesh->getSearchState();
+	if (m_bucket == -1)
+	{
+		initialiseSearch();
+	}
+	if (!findNextBucket())
+	{
+		// Every reachable cell is settled, destination may still have been reached from last bucket
+		if (getTentativeDistance(m_mesh->getFinishPosition()) != UNREACHED_DISTANCE)
+		{
+			finishSearch();
+		}
+		else
+		{
+			m_isFinished = true;
+		}
+		return;
+	}
+	for (auto& settled : m_localSettled)
+	{
+		settled.clear();
+	}
+	// Light moves may put cells back into current bucket, repeat until it stays empty
+	gatherFrontier();
+	while (!m_frontier.empty())
+	{
+		m_threadPool.parallelFor(static_cast<int>(m_frontier.size()), CHUNK_SIZE, [this](int threadIndex, int begin, int end)
+			{
+				for (int i = begin; i < end; ++i)
+				{
+					int index = m_frontier[i];
+					int distance = getTentativeDistance(index);
+					// Skip cells which moved to lower bucket meanwhile and duplicates relaxed at the same distance
+					if (distance / m_delta != m_bucket)
+					{
+						continue;
+					}
+					int relaxedDistance = m_relaxedDistance[index].exchange(distance, std::memory_order_relaxed);
+					if (relaxedDistance == distance)
+					{
+						continue;
+					}
+					if (relaxedDistance == UNREACHED_DISTANCE)
+					{
+						m_localSettled[threadIndex].push_back(index);
+					}
+					relaxCell<true>(index, distance, threadIndex);
+				}
+			});
+		m_lightRounds++;
+		gatherFrontier();
+	}
+	m_settled.clear();
+	for (auto& settled : m_localSettled)
+	{
+		m_settled.insert(m_settled.end(), settled.begin(), settled.end());
+	}
+	// Distances of current bucket are final, heavy moves always land in later buckets
+	m_threadPool.parallelFor(static_cast<int>(m_settled.size()), CHUNK_SIZE, [&](int threadIndex, int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				int index = m_settled[i];
+				std::uint64_t packed = m_tentative[index].load(std::memory_order_relaxed);
+				relaxCell<false>(index, static_cast<int>(packed >> 4), threadIndex);
+				if (cellTypes[index] != SquareType::START)
+				{
+					searchState.visit(index, SquareType::PROCESSED);
+					searchState.setDistance(index, static_cast<int>(packed >> 4));
+					searchState.setParent(index, static_cast<std::uint8_t>(packed & 0xF));
+				}
+			}
+		});
+	m_squareProcessed += static_cast<int>(m_settled.size());
+	if constexpr (Visualise)
+	{
+		for (int index : m_settled)
+		{
+			if (cellTypes[index] != SquareType::START)
+			{
+				m_mesh->setCellColor(SquareType::PROCESSED, index);
+			}
+		}
+		for (auto& buckets : m_localBuckets)
+		{
+			for (auto& bucket : buckets)
+			{
+				for (int index : bucket)
+				{
+					if (!searchState.isVisited(index))
+					{
+						m_mesh->setCellColor(SquareType::QUEUED, index);
+					}
+				}
+			}
+		}
+	}
+	// Destination is never queued, its distance is final once it falls below next bucket
+	if (getTentativeDistance(m_mesh->getFinishPosition()) / m_delta <= m_bucket)
+	{
+		finishSearch();
+		return;
+	}
+	m_bucket++;
+}
+
+////////////////////////////////////////////////////////////
+void DeltaSteppingSolver::initialiseSearch()
+{
+	std::uint64_t unreached = (static_cast<std::uint64_t>(UNREACHED_DISTANCE) << 4) | 0xF;
+	m_threadPool.parallelFor(m_mesh->getCellCount(), CHUNK_SIZE * 16, [&](int, int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				m_tentative[i].store(unreached, std::memory_order_relaxed);
+				m_relaxedDistance[i].store(UNREACHED_DISTANCE, std::memory_order_relaxed);
+			}
+		});
+	int startIndex = m_mesh->getStartPosition();
+	m_tentative[startIndex].store(0, std::memory_order_relaxed);
+	m_localBuckets[0][0].push_back(startIndex);
+	m_bucket = 0;
+}
+
+////////////////////////////////////////////////////////////
+void DeltaSteppingSolver::finishSearch()
+{
+	SearchState& searchState = m_mesh->getSearchState();
+	int finishIndex = m_mesh->getFinishPosition();
+	std::uint64_t packed = m_tentative[finishIndex].load(std::memory_order_relaxed);
+	searchState.visit(finishIndex, SquareType::QUEUED);
+	searchState.setDistance(finishIndex, static_cast<int>(packed >> 4));
+	searchState.setParent(finishIndex, static_cast<std::uint8_t>(packed & 0xF));
+	m_isFound = true;
+	beginPath(getParentIndex(finishIndex, searchState.getParent(finishIndex), m_mesh->getMeshSize().x));
+}
+
+////////////////////////////////////////////////////////////
+bool DeltaSteppingSolver::findNextBucket()
+{
+	for (int i = 0; i < m_slotCount; ++i, ++m_bucket)
+	{
+		for (auto& buckets : m_localBuckets)
+		{
+			if (!buckets[m_bucket % m_slotCount].empty())
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+void DeltaSteppingSolver::gatherFrontier()
+{
+	int slot = m_bucket % m_slotCount;
+	m_frontier.clear();
+	for (auto& buckets : m_localBuckets)
+	{
+		m_frontier.insert(m_frontier.end(), buckets[slot].begin(), buckets[slot].end());
+		buckets[slot].clear();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<bool Light>
+void DeltaSteppingSolver::relaxCell(int index, int distance, int threadIndex)
+{
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	std::vector<std::vector<int>>& buckets = m_localBuckets[threadIndex];
+	for (auto [nextIndex, direction] : m_mesh->getNeighbours(index))
+	{
+		if (cellTypes[nextIndex] != SquareType::EMPTY && cellTypes[nextIndex] != SquareType::FINISH)
+		{
+			continue;
+		}
+		int weight = cellWeights[nextIndex];
+		if ((weight <= m_delta) != Light)
+		{
+			continue;
+		}
+		int nextDistance = distance + weight;
+		if (tryImprove(nextIndex, nextDistance, direction) && cellTypes[nextIndex] != SquareType::FINISH)
+		{
+			buckets[(nextDistance / m_delta) % m_slotCount].push_back(nextIndex);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+#include "MeshSolver.h"
+#include "src/Utility/ThreadPool.h"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+
+/// <summary>
+/// A solver that uses parallel delta-stepping to find the shortest path from a starting point to a destination point on a weighted Mesh.
+/// Cells are grouped into buckets of width delta by tentative distance, each step settles one bucket:
+/// light moves (weight up to delta) are relaxed in parallel rounds until bucket stops changing, then heavy moves of settled cells are relaxed once.
+/// Path weight is the same as in DjikstraSolver.
+/// </summary>
+class DeltaSteppingSolver : public MeshSolver
+{
+public:
+	/// <summary>
+	/// Constructs an DeltaSteppingSolver object that will operate on the given Mesh
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	/// <param name="delta">Width of distance bucket (1 behaves like Dial algorithm, MAX_CELL_WEIGHT makes every move light)</param>
+	/// <param name="threadCount">Number of threads processing each bucket</param>
+	DeltaSteppingSolver(Mesh* mesh, int delta = DEFAULT_DELTA, int threadCount = static_cast<int>(std::thread::hardware_concurrency()));
+	/// <summary>
+	/// Resets the solver to its initial state
+	/// </summary>
+	void reset() override;
+	/// <summary>
+	/// Reset starting position of solver;
+	/// </summary>
+	void resetStartPosition() override;
+	/// <summary>
+	/// Returns a string representing the name of the solver.
+	/// </summary>
+	/// <returns></returns>
+	std::string getSolverName() override { return "DELTA-STEPPING Solver"; }
+	/// <summary>
+	/// Get width of distance bucket
+	/// </summary>
+	/// <returns>Delta</returns>
+	int getDelta() const { return m_delta; }
+	/// <summary>
+	/// Returns number of parallel light relaxation rounds in last search.
+	/// </summary>
+	/// <returns>Number of rounds</returns>
+	int getLightRounds() const { return m_lightRounds; }
+	static constexpr int DEFAULT_DELTA = 3;			//!< Default bucket width
+private:
+	/// <summary>
+	/// Updates the solver by settling one bucket.
+	/// This method is called repeatedly until the algorithm finds the destination point or determines that no path exists.
+	/// </summary>
+	virtual void updateSolver() override;
+	/// <summary>
+	/// Updates the path after the algorithm has finished.
+	/// This method is called once the destination point has been reached
+	/// </summary>
+	virtual void updatePath() override;
+	/// <summary>
+	/// Runs the delta-stepping algorithm until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Settles lowest non-empty bucket.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepSolver();
+	/// <summary>
+	/// Reset tentative distances of all cells and queue starting point
+	/// </summary>
+	void initialiseSearch();
+	/// <summary>
+	/// Find lowest bucket holding any cell, starting from current one
+	/// </summary>
+	/// <returns>True if such bucket exists</returns>
+	bool findNextBucket();
+	/// <summary>
+	/// Store final distance of destination point and start path reconstruction
+	/// </summary>
+	void finishSearch();
+	/// <summary>
+	/// Move cells of current bucket from per-thread buffers into frontier
+	/// </summary>
+	void gatherFrontier();
+	/// <summary>
+	/// Relax moves of one cell into its neighbours
+	/// </summary>
+	/// <typeparam name="Light">Whether light (weight up to delta) or heavy moves are relaxed</typeparam>
+	/// <param name="index">Index of cell</param>
+	/// <param name="distance">Distance of cell</param>
+	/// <param name="threadIndex">Index of calling thread</param>
+	template<bool Light>
+	void relaxCell(int index, int distance, int threadIndex);
+	/// <summary>
+	/// Lower tentative distance of cell if given one is shorter
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <param name="distance">New distance</param>
+	/// <param name="direction">Direction code of move which reached the cell</param>
+	/// <returns>True if distance was lowered</returns>
+	bool tryImprove(int index, int distance, std::uint8_t direction)
+	{
+		// Distance and parent are packed into one word so both change together, ties keep lower direction code
+		std::uint64_t packed = (static_cast<std::uint64_t>(distance) << 4) | direction;
+		std::uint64_t current = m_tentative[index].load(std::memory_order_relaxed);
+		while (packed < current)
+		{
+			if (m_tentative[index].compare_exchange_weak(current, packed, std::memory_order_relaxed))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+	/// <summary>
+	/// Get tentative distance of cell
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Distance (UNREACHED_DISTANCE if cell was not reached)</returns>
+	int getTentativeDistance(int index) const { return static_cast<int>(m_tentative[index].load(std::memory_order_relaxed) >> 4); }
+private:
+	static constexpr int CHUNK_SIZE = 256;			//!< Number of cells handed to thread at once
+	static constexpr int UNREACHED_DISTANCE = std::numeric_limits<int>::max();	//!< Tentative distance of cell which was not reached yet
+	ThreadPool m_threadPool;						//!< Threads processing buckets
+	int m_delta;									//!< Width of distance bucket
+	int m_slotCount;								//!< Number of buckets which can hold cells at the same time
+	std::unique_ptr<std::atomic<std::uint64_t>[]> m_tentative;	//!< Tentative distance (upper bits) and parent direction (lowest 4 bits) of each cell
+	std::unique_ptr<std::atomic<int>[]> m_relaxedDistance;		//!< Distance at which cell was last relaxed, avoids relaxing duplicates twice
+	std::vector<std::vector<std::vector<int>>> m_localBuckets;	//!< Circular buckets of cells filled by each thread
+	std::vector<std::vector<int>> m_localSettled;	//!< Cells settled in current bucket by each thread
+	std::vector<int> m_frontier;					//!< Cells of current light relaxation round
+	std::vector<int> m_settled;						//!< Cells settled in current bucket
+	int m_bucket{ -1 };								//!< Index of current bucket (-1 before search starts)
+	int m_lightRounds{};							//!< Number of light relaxation rounds
+};
\ No newline at end of file
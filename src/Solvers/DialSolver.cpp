@@ -0,0 +1,152 @@
+#include "DialSolver.h"
+#include <tuple>
+
+////////////////////////////////////////////////////////////
+DialSolver::DialSolver(Mesh* mesh, DialQueue queue) : MeshSolver(mesh), m_bucketQueue(Mesh::MAX_CELL_WEIGHT)
+{
+	if (queue == DialQueue::AUTO)
+	{
+		m_useRadixHeap = Mesh::MAX_CELL_WEIGHT > MAX_BUCKET_WEIGHT;
+	}
+	else
+	{
+		m_useRadixHeap = queue == DialQueue::RADIX_HEAP;
+	}
+	reset();
+}
+
+////////////////////////////////////////////////////////////
+void DialSolver::reset()
+{
+	resetStartPosition();
+	resetSolver();
+}
+
+void DialSolver::resetStartPosition()
+{
+	m_bucketQueue.clear();
+	m_radixHeap.clear();
+	if (m_useRadixHeap)
+	{
+		m_radixHeap.push(m_mesh->getStartPosition(), 0);
+	}
+	else
+	{
+		m_bucketQueue.push(m_mesh->getStartPosition(), 0);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void DialSolver::updateSolver()
+{
+	if (m_useRadixHeap)
+	{
+		stepSolver<true>(m_radixHeap);
+	}
+	else
+	{
+		stepSolver<true>(m_bucketQueue);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void DialSolver::updatePath()
+{
+	stepParentPath<true>();
+}
+
+////////////////////////////////////////////////////////////
+void DialSolver::runSolver()
+{
+	if (m_useRadixHeap)
+	{
+		while (!m_isFound && !m_isFinished)
+		{
+			stepSolver<false>(m_radixHeap);
+		}
+	}
+	else
+	{
+		while (!m_isFound && !m_isFinished)
+		{
+			stepSolver<false>(m_bucketQueue);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void DialSolver::runPath()
+{
+	while (!m_isFinished)
+	{
+		stepParentPath<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<bool Visualise, typename Queue>
+void DialSolver::stepSolver(Queue& queue)
+{
+	sf::Vector2i meshSize = m_mesh->getMeshSize();
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	SearchState& searchState = m_mesh->getSearchState();
+
+	// Queue does not support decrease-key, skip entries of cells which were improved or already processed
+	auto [topIndex, topDistance] = queue.pop();
+	while (searchState.getState(topIndex) == SquareType::PROCESSED || topDistance != searchState.getDistance(topIndex))
+	{
+		if (queue.empty())
+		{
+			m_isFinished = true;
+			return;
+		}
+		std::tie(topIndex, topDistance) = queue.pop();
+	}
+	if (cellTypes[topIndex] == SquareType::FINISH)
+	{
+		m_isFound = true;
+		beginPath(getParentIndex(topIndex, searchState.getParent(topIndex), meshSize.x));
+		return;
+	}
+	m_squareProcessed++;
+	for (auto [nextIndex, direction] : m_mesh->getNeighbours(topIndex))
+	{
+		if (cellTypes[nextIndex] != SquareType::EMPTY && cellTypes[nextIndex] != SquareType::FINISH)
+		{
+			continue;
+		}
+		int nextDistance = topDistance + cellWeights[nextIndex];
+		if (!searchState.isVisited(nextIndex))
+		{
+			searchState.visit(nextIndex, SquareType::QUEUED);
+			if constexpr (Visualise)
+			{
+				if (cellTypes[nextIndex] == SquareType::EMPTY)
+				{
+					m_mesh->setCellColor(SquareType::QUEUED, nextIndex);
+				}
+			}
+		}
+		else if (searchState.getState(nextIndex) != SquareType::QUEUED || nextDistance >= searchState.getDistance(nextIndex))
+		{
+			continue;
+		}
+		searchState.setDistance(nextIndex, nextDistance);
+		searchState.setParent(nextIndex, direction);
+		queue.push(nextIndex, nextDistance);
+	}
+	// Mark current Cell as finished
+	if (cellTypes[topIndex] != SquareType::START)
+	{
+		searchState.setState(topIndex, SquareType::PROCESSED);
+		if constexpr (Visualise)
+		{
+			m_mesh->setCellColor(SquareType::PROCESSED, topIndex);
+		}
+	}
+	if (queue.empty())
+	{
+		m_isFinished = true;
+	}
+}
\ No newline at end of file
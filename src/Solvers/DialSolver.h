@@ -0,0 +1,73 @@
+#pragma once
+#include "MeshSolver.h"
+#include "src/Utility/BucketQueue.h"
+#include "src/Utility/RadixHeap.h"
+
+/// <summary>
+/// Priority queue used by DialSolver
+/// </summary>
+enum class DialQueue
+{
+	AUTO,			//!< Bucket queue if cell weights are small enough, radix heap otherwise
+	BUCKET,			//!< Circular bucket queue (O(1) operations)
+	RADIX_HEAP,		//!< Radix heap (works for any weight width)
+};
+
+/// <summary>
+/// A solver that uses Dial's variant of the Djikstra algorithm (integer bucket queue) to find the shortest path from a starting point to a destination point on a Mesh.
+/// </summary>
+class DialSolver : public MeshSolver
+{
+public:
+	/// <summary>
+	/// Constructs an DialSolver object that will operate on the given Mesh
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	/// <param name="queue">Type of priority queue</param>
+	DialSolver(Mesh* mesh, DialQueue queue = DialQueue::AUTO);
+	/// <summary>
+	/// Resets the solver to its initial state
+	/// </summary>
+	void reset() override;
+	/// <summary>
+	/// Reset starting position of solver;
+	/// </summary>
+	void resetStartPosition() override;
+	/// <summary>
+	/// Returns a string representing the name of the solver.
+	/// </summary>
+	/// <returns></returns>
+	std::string getSolverName() override { return m_useRadixHeap ? "DIAL Solver (radix heap)" : "DIAL Solver"; }
+private:
+	/// <summary>
+	/// Updates the solver by performing one iteration of the Dial algorithm.
+	/// This method is called repeatedly until the algorithm finds the destination point or determines that no path exists.
+	/// </summary>
+	virtual void updateSolver() override;
+	/// <summary>
+	/// Updates the path after the algorithm has finished.
+	/// This method is called once the destination point has been reached
+	/// </summary>
+	virtual void updatePath() override;
+	/// <summary>
+	/// Runs the Dial algorithm until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Performs one iteration of the Dial algorithm.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	/// <typeparam name="Queue">Type of priority queue</typeparam>
+	/// <param name="queue">Priority queue of cells</param>
+	template<bool Visualise, typename Queue>
+	void stepSolver(Queue& queue);
+private:
+	static constexpr int MAX_BUCKET_WEIGHT = 64;	//!< Highest cell weight for which bucket queue is used in AUTO mode
+	BucketQueue m_bucketQueue;						//!< Bucket queue of cells and their distances from the starting point
+	RadixHeap m_radixHeap;							//!< Radix heap used when cell weights are too wide for buckets
+	bool m_useRadixHeap{ false };					//!< Which of the queues is used
+};
\ No newline at end of file
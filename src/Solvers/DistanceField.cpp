@@ -0,0 +1,175 @@
+#include "DistanceField.h"
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+DistanceField::DistanceField(Mesh* mesh) : m_mesh(mesh)
+{
+	int cellCount = mesh->getCellCount();
+	m_cellContainer.resize(cellCount);
+	m_distances.assign(cellCount, NO_DISTANCE);
+	m_directions.resize(cellCount);
+	m_terrain.resize(cellCount);
+}
+
+////////////////////////////////////////////////////////////
+void DistanceField::update()
+{
+	m_processedSquares = 0;
+	if (m_target != m_mesh->getFinishPosition() || !m_mesh->getEditedCells(m_revision, m_editedCells))
+	{
+		build();
+	}
+	else if (!m_editedCells.empty())
+	{
+		repair(m_editedCells);
+	}
+	m_revision = m_mesh->getRevision();
+}
+
+////////////////////////////////////////////////////////////
+SolveResult DistanceField::getPath(int start) const
+{
+	SolveResult result;
+	if (m_distances[start] == NO_DISTANCE)
+	{
+		return result;
+	}
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	result.isFound = true;
+	result.pathWeight = cellWeights[start];
+	for (int index = getNextStep(start); index != m_target; index = getNextStep(index))
+	{
+		result.path.push_back(index);
+		result.pathWeight += cellWeights[index];
+	}
+	// Solvers list path from destination side
+	std::reverse(result.path.begin(), result.path.end());
+	result.pathLength = static_cast<int>(result.path.size()) + 1;
+	return result;
+}
+
+////////////////////////////////////////////////////////////
+std::size_t DistanceField::getMemoryUsage() const
+{
+	return m_distances.capacity() * sizeof(int) + m_directions.capacity() + m_terrain.capacity()
+		+ (m_invalidCells.capacity() + m_cheaperCells.capacity() + m_editedCells.capacity()) * sizeof(int);
+}
+
+////////////////////////////////////////////////////////////
+void DistanceField::build()
+{
+	int cellCount = m_mesh->getCellCount();
+	for (int i = 0; i < cellCount; ++i)
+	{
+		m_terrain[i] = getTerrain(i);
+	}
+	std::fill(m_distances.begin(), m_distances.end(), NO_DISTANCE);
+	m_target = m_mesh->getFinishPosition();
+	m_distances[m_target] = 0;
+	m_cellContainer.clear();
+	m_cellContainer.push(m_target, 0);
+	propagate();
+}
+
+////////////////////////////////////////////////////////////
+void DistanceField::repair(const std::vector<int>& cells)
+{
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	m_cellContainer.clear();
+	m_invalidCells.clear();
+	m_cheaperCells.clear();
+	for (int index : cells)
+	{
+		std::uint8_t terrain = getTerrain(index);
+		std::uint8_t oldTerrain = m_terrain[index];
+		if (terrain == oldTerrain)
+		{
+			// Start or destination marker moved without changing terrain
+			continue;
+		}
+		m_terrain[index] = terrain;
+		if (index == m_target)
+		{
+			// Every path ends by entering destination
+			build();
+			return;
+		}
+		if (oldTerrain == 0)
+		{
+			// Opened cell takes distance from its neighbours
+			m_invalidCells.push_back(index);
+		}
+		else if (terrain != 0 && terrain < oldTerrain)
+		{
+			// Cheaper cell only offers shorter distances to its neighbours
+			m_cheaperCells.push_back(index);
+		}
+		else if (m_distances[index] != NO_DISTANCE)
+		{
+			m_distances[index] = NO_DISTANCE;
+			m_invalidCells.push_back(index);
+		}
+	}
+	// Cells whose next steps lead through dropped cells may be farther from destination now, so they are dropped too
+	for (size_t i = 0; i < m_invalidCells.size(); ++i)
+	{
+		for (auto [nextIndex, direction] : m_mesh->getNeighbours(m_invalidCells[i]))
+		{
+			if (m_distances[nextIndex] != NO_DISTANCE && nextIndex != m_target && m_directions[nextIndex] == direction)
+			{
+				m_distances[nextIndex] = NO_DISTANCE;
+				m_invalidCells.push_back(nextIndex);
+			}
+		}
+	}
+	// Dropped cells restart from best distance offered by their neighbours
+	for (int index : m_invalidCells)
+	{
+		if (m_terrain[index] == 0)
+		{
+			continue;
+		}
+		for (auto [nextIndex, direction] : m_mesh->getNeighbours(index))
+		{
+			if (m_distances[nextIndex] != NO_DISTANCE && m_distances[nextIndex] + cellWeights[nextIndex] < m_distances[index])
+			{
+				m_distances[index] = m_distances[nextIndex] + cellWeights[nextIndex];
+				m_directions[index] = 8 - direction;
+			}
+		}
+		if (m_distances[index] != NO_DISTANCE)
+		{
+			m_cellContainer.push(index, m_distances[index]);
+		}
+	}
+	for (int index : m_cheaperCells)
+	{
+		if (m_distances[index] != NO_DISTANCE)
+		{
+			m_cellContainer.push(index, m_distances[index]);
+		}
+	}
+	propagate();
+}
+
+////////////////////////////////////////////////////////////
+void DistanceField::propagate()
+{
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	while (!m_cellContainer.empty())
+	{
+		auto [index, distance] = m_cellContainer.pop();
+		m_processedSquares++;
+		// Neighbour reaches destination by entering this cell
+		int nextDistance = distance + cellWeights[index];
+		for (auto [nextIndex, direction] : m_mesh->getNeighbours(index))
+		{
+			if (nextDistance < m_distances[nextIndex])
+			{
+				m_distances[nextIndex] = nextDistance;
+				m_directions[nextIndex] = direction;
+				m_cellContainer.push(nextIndex, nextDistance);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+#include "MeshSolver.h"
+#include "src/Utility/IndexedHeap.h"
+#include <cstdint>
+#include <limits>
+
+/// <summary>
+/// Distance of every cell to destination with direction of next step (flow field), built by one reverse Djikstra search.
+/// Once built, path from any start is read by following next steps without searching.
+/// Field is kept outside mesh search state, so solvers can run on the same mesh, and it is repaired incrementally after walls or weights change.
+/// Every non-wall cell counts as passable (start is not avoided), which does not change shortest path from the start itself.
+/// </summary>
+class DistanceField
+{
+public:
+	static constexpr int NO_DISTANCE = std::numeric_limits<int>::max();	//!< Distance of cell which cannot reach destination
+	/// <summary>
+	/// Create empty field for mesh (nothing is computed until first update)
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	DistanceField(Mesh* mesh);
+	/// <summary>
+	/// Bring field up to date with mesh: rebuild it if destination moved, otherwise repair cells affected by edits
+	/// </summary>
+	void update();
+	/// <summary>
+	/// Get distance from cell to destination (weights of entered cells)
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Distance or NO_DISTANCE if destination cannot be reached</returns>
+	int getDistance(int index) const { return m_distances[index]; }
+	/// <summary>
+	/// Get next cell on shortest path from cell to destination
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Index of next cell or -1 for destination and cells which cannot reach it</returns>
+	int getNextStep(int index) const
+	{
+		if (m_distances[index] == NO_DISTANCE || index == m_target)
+		{
+			return -1;
+		}
+		return getParentIndex(index, m_directions[index], m_mesh->getMeshSize().x);
+	}
+	/// <summary>
+	/// Get direction code of move from next cell into given cell (reverse of step towards destination)
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Direction code</returns>
+	std::uint8_t getDirection(int index) const { return m_directions[index]; }
+	/// <summary>
+	/// Read path from start to destination by following next steps
+	/// </summary>
+	/// <param name="start">Index of starting cell</param>
+	/// <returns>Path in the same form as solvers return it (no cells are processed)</returns>
+	SolveResult getPath(int start) const;
+	/// <summary>
+	/// Get destination of field
+	/// </summary>
+	/// <returns>Index of destination cell</returns>
+	int getTarget() const { return m_target; }
+	/// <summary>
+	/// Get number of cells settled by last update
+	/// </summary>
+	/// <returns>Number of cells</returns>
+	int getProcessedSquares() const { return m_processedSquares; }
+	/// <summary>
+	/// Get memory held by field
+	/// </summary>
+	/// <returns>Number of bytes</returns>
+	std::size_t getMemoryUsage() const;
+private:
+	/// <summary>
+	/// Compute distances of all cells from scratch
+	/// </summary>
+	void build();
+	/// <summary>
+	/// Recompute distances of cells whose shortest path could change after given cells were edited
+	/// </summary>
+	/// <param name="cells">Edited cells</param>
+	void repair(const std::vector<int>& cells);
+	/// <summary>
+	/// Settle queued cells and propagate their distances to neighbours
+	/// </summary>
+	void propagate();
+	/// <summary>
+	/// Get terrain value of cell
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Weight of cell or 0 for wall</returns>
+	std::uint8_t getTerrain(int index) const
+	{
+		return m_mesh->getCellTypes()[index] == SquareType::FULL ? 0 : m_mesh->getCellWeights()[index];
+	}
+private:
+	Mesh* m_mesh;								//!< Mesh on which distances are measured
+	IndexedHeap<int> m_cellContainer;			//!< Cells waiting to be settled
+	std::vector<int> m_distances;				//!< Distance of each cell to destination
+	std::vector<std::uint8_t> m_directions;		//!< Direction code of move from next cell into each cell
+	std::vector<std::uint8_t> m_terrain;		//!< Weight of each cell (0 for wall) the field was computed for
+	std::vector<int> m_invalidCells;			//!< Cells whose distances are recomputed by repair
+	std::vector<int> m_cheaperCells;			//!< Cells whose weight dropped, queued by repair to relax their neighbours
+	std::vector<int> m_editedCells;				//!< Cells edited since last update
+	int m_target{ -1 };							//!< Destination of field
+	std::uint32_t m_revision{};					//!< Mesh revision of field
+	int m_processedSquares{};					//!< Number of cells settled by last update
+};
\ No newline at end of file
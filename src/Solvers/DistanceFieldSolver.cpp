@@ -0,0 +1,75 @@
+#include "DistanceFieldSolver.h"
+
+////////////////////////////////////////////////////////////
+DistanceFieldSolver::DistanceFieldSolver(Mesh* mesh) : MeshSolver(mesh), m_field(mesh)
+{
+	reset();
+}
+
+////////////////////////////////////////////////////////////
+void DistanceFieldSolver::reset()
+{
+	resetStartPosition();
+	resetSolver();
+}
+
+void DistanceFieldSolver::resetStartPosition()
+{
+}
+
+////////////////////////////////////////////////////////////
+void DistanceFieldSolver::updateSolver()
+{
+	readField();
+}
+
+////////////////////////////////////////////////////////////
+void DistanceFieldSolver::updatePath()
+{
+	stepParentPath<true>();
+}
+
+////////////////////////////////////////////////////////////
+void DistanceFieldSolver::runSolver()
+{
+	readField();
+}
+
+////////////////////////////////////////////////////////////
+void DistanceFieldSolver::runPath()
+{
+	while (!m_isFinished)
+	{
+		stepParentPath<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void DistanceFieldSolver::readField()
+{
+	m_field.update();
+	m_squareProcessed = m_field.getProcessedSquares();
+	int startIndex = m_mesh->getStartPosition();
+	int finishIndex = m_mesh->getFinishPosition();
+	if (m_field.getDistance(startIndex) == DistanceField::NO_DISTANCE)
+	{
+		m_isFinished = true;
+		return;
+	}
+	sf::Vector2i meshSize = m_mesh->getMeshSize();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	SearchState& searchState = m_mesh->getSearchState();
+	int distance = 0;
+	for (int index = startIndex; index != finishIndex; )
+	{
+		int nextIndex = m_field.getNextStep(index);
+		distance += cellWeights[nextIndex];
+		searchState.visit(nextIndex, SquareType::PROCESSED);
+		searchState.setDistance(nextIndex, distance);
+		// Field stores moves towards cells, path needs moves away from them
+		searchState.setParent(nextIndex, 8 - m_field.getDirection(index));
+		index = nextIndex;
+	}
+	m_isFound = true;
+	beginPath(getParentIndex(finishIndex, searchState.getParent(finishIndex), meshSize.x));
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+#include "DistanceField.h"
+
+/// <summary>
+/// A solver that answers path queries from a DistanceField rooted at the destination.
+/// Field is built once and only repaired after edits, so moving start or re-running search costs no searching.
+/// </summary>
+class DistanceFieldSolver : public MeshSolver
+{
+public:
+	/// <summary>
+	/// Constructs an DistanceFieldSolver object that will operate on the given Mesh
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	DistanceFieldSolver(Mesh* mesh);
+	/// <summary>
+	/// Resets the solver to its initial state (field is kept and repaired at next search)
+	/// </summary>
+	void reset() override;
+	/// <summary>
+	/// Reset starting position of solver;
+	/// </summary>
+	void resetStartPosition() override;
+	/// <summary>
+	/// Returns a string representing the name of the solver.
+	/// </summary>
+	/// <returns></returns>
+	std::string getSolverName() override { return "Distance Field Solver"; }
+	/// <summary>
+	/// Returns distance field used by solver.
+	/// </summary>
+	/// <returns>Distance field</returns>
+	const DistanceField& getDistanceField() const { return m_field; }
+private:
+	/// <summary>
+	/// Updates the field and reads path from it at once.
+	/// </summary>
+	virtual void updateSolver() override;
+	/// <summary>
+	/// Updates the path after the algorithm has finished.
+	/// This method is called once the destination point has been reached
+	/// </summary>
+	virtual void updatePath() override;
+	/// <summary>
+	/// Updates the field and reads path from it, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Bring field up to date and store its path from start in search state
+	/// </summary>
+	void readField();
+private:
+	DistanceField m_field;	//!< Distances of all cells to destination
+};
\ No newline at end of file
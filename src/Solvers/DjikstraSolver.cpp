@@ -2,131 +2,130 @@
 #include <limits>
 
 ////////////////////////////////////////////////////////////
-DjikstraSolver::DjikstraSolver(Mesh* mesh) : MeshSolver(mesh)
+template<typename Connectivity, typename Cost>
+DjikstraSolver<Connectivity, Cost>::DjikstraSolver(Mesh* mesh, HeapMode heapMode) : MeshSolver(mesh), m_cellContainer(heapMode)
 {
+	m_cellContainer.resize(mesh->getCellCount());
 	reset();
 }
 
 ////////////////////////////////////////////////////////////
-void DjikstraSolver::reset()
+template<typename Connectivity, typename Cost>
+void DjikstraSolver<Connectivity, Cost>::reset()
 {
 	resetStartPosition();
 	resetSolver();
 }
 
-void DjikstraSolver::resetStartPosition()
+template<typename Connectivity, typename Cost>
+void DjikstraSolver<Connectivity, Cost>::resetStartPosition()
 {
-	m_cellContainer = pairPrioQueue();
-	m_cellContainer.push({ m_mesh->getStartPosition(),0 });
+	m_cellContainer.clear();
+	m_cellContainer.push(m_mesh->getStartPosition(), 0);
 }
 
 ////////////////////////////////////////////////////////////
-void DjikstraSolver::updateSolver()
+template<typename Connectivity, typename Cost>
+void DjikstraSolver<Connectivity, Cost>::updateSolver()
 {
-	sf::Vector2i meshSize = m_mesh->getMeshSize();
-	std::vector<Cell>& cellVec = m_mesh->getSquareVec();
-	auto [topIndex, _] = m_cellContainer.top();
+	stepSolver<true>();
+}
 
-	m_squareProcessed++;
-	auto [row, column] = mapIndex2D(topIndex, meshSize.x);
-	for (int i = -1; i <= 1; i++)
-	{
-		if (row + i < 0 || row + i >= meshSize.y)
-		{
-			continue;
-		}
-		for (int j = -1; j <= 1; j++)
-		{
-			if (i == 0 && j == 0)
-				continue;
-			if (column + j < 0 || column + j >= meshSize.x)
-			{
-				continue;
-			}
-			int nextIndex = mapIndex1D(row + i, column + j, meshSize.x);
-			if (cellVec[nextIndex].cellType == SquareType::FINISH)
-			{
-				m_isFound = true;
-				break;
-			}
-			else if (cellVec[nextIndex].cellType == SquareType::EMPTY)
-			{
-				cellVec[nextIndex].cellType = SquareType::QUEUED;
-				cellVec[nextIndex].distance = cellVec[topIndex].distance + cellVec[nextIndex].weight;
-				m_mesh->setCellColor(SquareType::QUEUED, nextIndex);
-				m_cellContainer.push({ nextIndex,cellVec[nextIndex].distance });
-			}
-		}
-		if (m_isFound)
-		{
-			break;
-		}
-	}
-	// Mark current Cell as finished
-	if (cellVec[topIndex].cellType != SquareType::START)
-	{
-		cellVec[topIndex].cellType = SquareType::PROCESSED;
-		m_mesh->setCellColor(SquareType::PROCESSED, topIndex);
-	}
-	if (!m_isFound)
+////////////////////////////////////////////////////////////
+template<typename Connectivity, typename Cost>
+void DjikstraSolver<Connectivity, Cost>::updatePath()
+{
+	stepParentPath<true>();
+}
+
+////////////////////////////////////////////////////////////
+template<typename Connectivity, typename Cost>
+void DjikstraSolver<Connectivity, Cost>::runSolver()
+{
+	while (!m_isFound && !m_isFinished)
 	{
-		m_cellContainer.pop();
-		if (m_cellContainer.empty())
-		{
-			m_isFinished = true;
-		}
+		stepSolver<false>();
 	}
-	else
+}
+
+////////////////////////////////////////////////////////////
+template<typename Connectivity, typename Cost>
+void DjikstraSolver<Connectivity, Cost>::runPath()
+{
+	while (!m_isFinished)
 	{
-		m_cellContainer = pairPrioQueue();
-		m_cellContainer.push({ topIndex,cellVec[topIndex].distance });
+		stepParentPath<false>();
 	}
 }
 
 ////////////////////////////////////////////////////////////
-void DjikstraSolver::updatePath()
+template<typename Connectivity, typename Cost>
+template<bool Visualise>
+void DjikstraSolver<Connectivity, Cost>::stepSolver()
 {
 	sf::Vector2i meshSize = m_mesh->getMeshSize();
-	std::vector<Cell>& cellVec = m_mesh->getSquareVec();
-	auto [topIndex, distance] = m_cellContainer.top();
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	SearchState& searchState = m_mesh->getSearchState();
+	int topIndex = m_cellContainer.pop().first;
 
-	m_pathLength++;
-	m_pathWeight += cellVec[topIndex].weight;
-
-	auto [row, column] = mapIndex2D(topIndex, meshSize.x);
-	int minDistance{ std::numeric_limits<int>::max() };
-	int cellIndex{};
-	for (int i = -1; i <= 1; i++)
+	// Distance to destination is final only once it leaves the queue
+	if (cellTypes[topIndex] == SquareType::FINISH)
+	{
+		m_isFound = true;
+		beginPath(getParentIndex(topIndex, searchState.getParent(topIndex), meshSize.x), Cost::getStraightCost(Mesh::MIN_CELL_WEIGHT));
+		return;
+	}
+	m_squareProcessed++;
+	int topDistance = searchState.getDistance(topIndex);
+	for (auto [nextIndex, direction] : m_mesh->getNeighbours<Connectivity>(topIndex))
 	{
-		if (row + i < 0 || row + i >= meshSize.y)
+		if (cellTypes[nextIndex] != SquareType::EMPTY && cellTypes[nextIndex] != SquareType::FINISH)
 		{
 			continue;
 		}
-		for (int j = -1; j <= 1; j++)
+		int nextDistance = topDistance + Cost::getMoveCost(cellWeights[nextIndex], direction);
+		if (!searchState.isVisited(nextIndex))
 		{
-			if (i == 0 && j == 0)
-				continue;
-			if (column + j < 0 || column + j >= meshSize.x)
-			{
-				continue;
-			}
-			int nextIndex = mapIndex1D(row + i, column + j, meshSize.x);
-			if (cellVec[nextIndex].distance < minDistance)
+			searchState.visit(nextIndex, SquareType::QUEUED);
+			if constexpr (Visualise)
 			{
-				cellIndex = nextIndex;
-				minDistance = cellVec[nextIndex].distance;
+				if (cellTypes[nextIndex] == SquareType::EMPTY)
+				{
+					m_mesh->setCellColor(SquareType::QUEUED, nextIndex);
+				}
 			}
 		}
+		// Relax only cells still waiting in queue and only if new distance is shorter
+		else if (searchState.getState(nextIndex) != SquareType::QUEUED || nextDistance >= searchState.getDistance(nextIndex))
+		{
+			continue;
+		}
+		searchState.setDistance(nextIndex, nextDistance);
+		searchState.setParent(nextIndex, direction);
+		m_cellContainer.push(nextIndex, nextDistance);
 	}
-	if (cellVec[topIndex].distance == 0)
+	// Mark current Cell as finished
+	if (cellTypes[topIndex] != SquareType::START)
 	{
-		m_isFinished = true;
+		searchState.setState(topIndex, SquareType::PROCESSED);
+		if constexpr (Visualise)
+		{
+			m_mesh->setCellColor(SquareType::PROCESSED, topIndex);
+		}
 	}
-	else
+	if (m_cellContainer.empty())
 	{
-		cellVec[topIndex].cellType = SquareType::PATH;
-		m_mesh->setCellColor(SquareType::PATH, topIndex);
-		m_cellContainer.pop();
-		m_cellContainer.push({ cellIndex,minDistance });
+		m_isFinished = true;
 	}
 }
+
+template class DjikstraSolver<FourConnectivity, UnitCost>;
+template class DjikstraSolver<FourConnectivity, WeightCost>;
+template class DjikstraSolver<FourConnectivity, OctileCost>;
+template class DjikstraSolver<EightConnectivity, UnitCost>;
+template class DjikstraSolver<EightConnectivity, WeightCost>;
+template class DjikstraSolver<EightConnectivity, OctileCost>;
+template class DjikstraSolver<NoCornerCuttingConnectivity, UnitCost>;
+template class DjikstraSolver<NoCornerCuttingConnectivity, WeightCost>;
+template class DjikstraSolver<NoCornerCuttingConnectivity, OctileCost>;
\ No newline at end of file
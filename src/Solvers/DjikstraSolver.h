@@ -1,21 +1,24 @@
 #pragma once
 #include "MeshSolver.h"
-#include <queue>
+#include "SearchPolicies.h"
+#include "src/Utility/IndexedHeap.h"
 
 /// <summary>
 /// A solver that uses the Djikstra algorithm to find a path from a starting point to a destination point on a Mesh.
+/// Instantiated in DjikstraSolver.cpp for every pair of policies from SearchPolicies.h.
 /// </summary>
+/// <typeparam name="Connectivity">Moves allowed between cells</typeparam>
+/// <typeparam name="Cost">Cost of moves</typeparam>
+template<typename Connectivity = EightConnectivity, typename Cost = WeightCost>
 class DjikstraSolver : public MeshSolver
 {
-	// Comparator struct to sort pairs in the priority queue by their second element in ascending order
-	struct CompareSecond {
-		bool operator()(const std::pair<int, int>& a, const std::pair<int, int>& b) const {
-			return a.second > b.second;
-		}
-	};
-	using pairPrioQueue = std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, CompareSecond>;
 public:
-	DjikstraSolver(Mesh* mesh);
+	/// <summary>
+	/// Constructs an DjikstraSolver object that will operate on the given Mesh
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	/// <param name="heapMode">How queued cells with shorter distance found are updated</param>
+	DjikstraSolver(Mesh* mesh, HeapMode heapMode = HeapMode::DECREASE_KEY);
 	/// <summary>
 	/// Resets the solver to its initial state
 	/// </summary>
@@ -28,7 +31,12 @@ public:
 	/// Returns a string representing the name of the solver.
 	/// </summary>
 	/// <returns></returns>
-	std::string getSolverName() override { return "DJIKSTRA Solver"; }
+	std::string getSolverName() override { return getPolicyName<Connectivity, Cost>("DJIKSTRA Solver"); }
+	/// <summary>
+	/// Returns priority queue operation counters of last search.
+	/// </summary>
+	/// <returns>Heap statistics</returns>
+	const HeapStats& getHeapStats() const { return m_cellContainer.getStats(); }
 private:
 	/// <summary>
 	/// Updates the solver by performing one iteration of the A* algorithm.
@@ -40,6 +48,20 @@ private:
 	/// This method is called once the destination point has been reached
 	/// </summary>
 	virtual void updatePath() override;
+	/// <summary>
+	/// Runs the Djikstra algorithm until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Performs one iteration of the Djikstra algorithm.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepSolver();
 private:
-	pairPrioQueue m_cellContainer;		//!< The priority queue of cell IDs and their distances from the starting point
+	IndexedHeap<int> m_cellContainer;	//!< The priority queue of cell IDs and their distances from the starting point
 };
\ No newline at end of file
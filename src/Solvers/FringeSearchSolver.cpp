@@ -0,0 +1,236 @@
+#include "FringeSearchSolver.h"
+#include "SearchPolicies.h"
+#include <climits>
+#include <cstdlib>
+
+namespace
+{
+	/// <summary>
+	/// Victim score which pins every entry (reached cells are needed for fringe links and path reconstruction)
+	/// </summary>
+	template<typename Value>
+	int pinEntry(const Value&) { return -1; }
+}
+
+////////////////////////////////////////////////////////////
+FringeSearchSolver::FringeSearchSolver(Mesh* mesh, std::size_t tableMegabytes) : MeshSolver(mesh)
+{
+	m_table.resize(tableMegabytes);
+	reset();
+}
+
+////////////////////////////////////////////////////////////
+void FringeSearchSolver::reset()
+{
+	resetStartPosition();
+	resetSolver();
+}
+
+void FringeSearchSolver::resetStartPosition()
+{
+	m_table.clear();
+	m_iterationCount = 0;
+	m_isOutOfMemory = false;
+	m_isInitialised = false;
+}
+
+////////////////////////////////////////////////////////////
+void FringeSearchSolver::updateSolver()
+{
+	stepSolver<true>();
+}
+
+////////////////////////////////////////////////////////////
+void FringeSearchSolver::updatePath()
+{
+	stepParentPath<true>();
+}
+
+////////////////////////////////////////////////////////////
+void FringeSearchSolver::runSolver()
+{
+	while (!m_isFound && !m_isFinished)
+	{
+		stepSolver<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void FringeSearchSolver::runPath()
+{
+	while (!m_isFinished)
+	{
+		stepParentPath<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<bool Visualise>
+void FringeSearchSolver::stepSolver()
+{
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	SearchState& searchState = m_mesh->getSearchState();
+	if (!m_isInitialised)
+	{
+		int startIndex = m_mesh->getStartPosition();
+		m_minWeight = m_mesh->getMinCellWeight();
+		auto [finishRow, finishColumn] = mapIndex2D(m_mesh->getFinishPosition(), m_mesh->getMeshSize().x);
+		m_finishRow = finishRow;
+		m_finishColumn = finishColumn;
+		m_table.clear();
+		m_head = m_table.insert(startIndex, pinEntry<FringeNode>);
+		m_table.getValue(m_head) = FringeNode{ 0, m_table.NO_SLOT, m_table.NO_SLOT, 0, true };
+		m_current = m_head;
+		m_threshold = estimate(startIndex);
+		m_nextThreshold = INT_MAX;
+		m_iterationCount = 1;
+		m_isInitialised = true;
+	}
+	if (m_current == m_table.NO_SLOT)
+	{
+		// End of pass, cells left in fringe are tried again with lowest g + h which did not fit
+		if (m_head == m_table.NO_SLOT || m_nextThreshold == INT_MAX)
+		{
+			m_isFinished = true;
+			return;
+		}
+		m_threshold = m_nextThreshold;
+		m_nextThreshold = INT_MAX;
+		m_current = m_head;
+		m_iterationCount++;
+	}
+	int slot = m_current;
+	int index = m_table.getKey(slot);
+	FringeNode& node = m_table.getValue(slot);
+	int nodeEstimate = node.distance + estimate(index);
+	if (nodeEstimate > m_threshold)
+	{
+		// Leave cell in later part of fringe
+		m_nextThreshold = std::min(m_nextThreshold, nodeEstimate);
+		m_current = node.next;
+		return;
+	}
+	if (cellTypes[index] == SquareType::FINISH)
+	{
+		m_isFound = true;
+		storePath(slot);
+		return;
+	}
+	m_squareProcessed++;
+	for (auto [nextIndex, direction] : m_mesh->getNeighbours(index))
+	{
+		if (cellTypes[nextIndex] != SquareType::EMPTY && cellTypes[nextIndex] != SquareType::FINISH)
+		{
+			continue;
+		}
+		int nextDistance = node.distance + cellWeights[nextIndex];
+		int nextSlot = m_table.find(nextIndex);
+		if (nextSlot == m_table.NO_SLOT)
+		{
+			nextSlot = m_table.insert(nextIndex, pinEntry<FringeNode>);
+			if (nextSlot == m_table.NO_SLOT)
+			{
+				m_isOutOfMemory = true;
+				m_isFinished = true;
+				return;
+			}
+			m_table.getValue(nextSlot).isListed = false;
+		}
+		else if (nextDistance >= m_table.getValue(nextSlot).distance)
+		{
+			continue;
+		}
+		else if (m_table.getValue(nextSlot).isListed)
+		{
+			unlink(nextSlot);
+		}
+		FringeNode& next = m_table.getValue(nextSlot);
+		next.distance = nextDistance;
+		next.direction = direction;
+		// Children are visited right after their parent in this pass
+		link(nextSlot, slot);
+		if constexpr (Visualise)
+		{
+			if (!searchState.isVisited(nextIndex) && cellTypes[nextIndex] == SquareType::EMPTY)
+			{
+				searchState.visit(nextIndex, SquareType::QUEUED);
+				m_mesh->setCellColor(SquareType::QUEUED, nextIndex);
+			}
+		}
+	}
+	m_current = node.next;
+	unlink(slot);
+	if constexpr (Visualise)
+	{
+		if (cellTypes[index] == SquareType::EMPTY && searchState.getState(index) != SquareType::PROCESSED)
+		{
+			searchState.visit(index, SquareType::PROCESSED);
+			m_mesh->setCellColor(SquareType::PROCESSED, index);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void FringeSearchSolver::link(int slot, int previous)
+{
+	FringeNode& node = m_table.getValue(slot);
+	FringeNode& previousNode = m_table.getValue(previous);
+	node.previous = previous;
+	node.next = previousNode.next;
+	node.isListed = true;
+	if (node.next != m_table.NO_SLOT)
+	{
+		m_table.getValue(node.next).previous = slot;
+	}
+	previousNode.next = slot;
+}
+
+////////////////////////////////////////////////////////////
+void FringeSearchSolver::unlink(int slot)
+{
+	FringeNode& node = m_table.getValue(slot);
+	if (node.previous != m_table.NO_SLOT)
+	{
+		m_table.getValue(node.previous).next = node.next;
+	}
+	else
+	{
+		m_head = node.next;
+	}
+	if (node.next != m_table.NO_SLOT)
+	{
+		m_table.getValue(node.next).previous = node.previous;
+	}
+	if (m_current == slot)
+	{
+		m_current = node.next;
+	}
+	node.isListed = false;
+}
+
+////////////////////////////////////////////////////////////
+void FringeSearchSolver::storePath(int slot)
+{
+	SearchState& searchState = m_mesh->getSearchState();
+	int width = m_mesh->getMeshSize().x;
+	int startIndex = m_mesh->getStartPosition();
+	int pathIndex = getParentIndex(m_table.getKey(slot), m_table.getValue(slot).direction, width);
+	int index = pathIndex;
+	while (index != startIndex)
+	{
+		const FringeNode& node = m_table.getValue(m_table.find(index));
+		searchState.visit(index, SquareType::PROCESSED);
+		searchState.setDistance(index, node.distance);
+		searchState.setParent(index, node.direction);
+		index = getParentIndex(index, node.direction, width);
+	}
+	beginPath(pathIndex, m_minWeight);
+}
+
+////////////////////////////////////////////////////////////
+int FringeSearchSolver::estimate(int index) const
+{
+	auto [row, column] = mapIndex2D(index, m_mesh->getMeshSize().x);
+	return ChebyshevHeuristic::estimate(std::abs(row - m_finishRow), std::abs(column - m_finishColumn), m_minWeight, m_minWeight);
+}
\ No newline at end of file
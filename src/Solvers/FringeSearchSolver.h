@@ -0,0 +1,125 @@
+#pragma once
+#include "MeshSolver.h"
+#include "src/Utility/TranspositionTable.h"
+
+/// <summary>
+/// A solver that uses Fringe Search to find the shortest path from a starting point to a destination point on a Mesh.
+/// Fringe is one linked list walked in passes: cells behind current position whose g + h exceeded threshold wait for next pass (later part),
+/// cells ahead of it are still tried in this pass (now part). Expanded cells put their children right after themselves, so no sorting is needed.
+/// Cells and links of list live in transposition table of fixed size. If table cannot hold a new cell, search stops without path
+/// and isOutOfMemory() is set, memory is never grown.
+/// </summary>
+class FringeSearchSolver : public MeshSolver
+{
+public:
+	static constexpr std::size_t DEFAULT_TABLE_MEGABYTES = 16;	//!< Default memory budget of transposition table
+	/// <summary>
+	/// Constructs an FringeSearchSolver object that will operate on the given Mesh
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	/// <param name="tableMegabytes">Memory budget of transposition table</param>
+	FringeSearchSolver(Mesh* mesh, std::size_t tableMegabytes = DEFAULT_TABLE_MEGABYTES);
+	/// <summary>
+	/// Resets the solver to its initial state
+	/// </summary>
+	void reset() override;
+	/// <summary>
+	/// Reset starting position of solver;
+	/// </summary>
+	void resetStartPosition() override;
+	/// <summary>
+	/// Returns a string representing the name of the solver.
+	/// </summary>
+	/// <returns></returns>
+	std::string getSolverName() override { return "Fringe Search Solver"; }
+	/// <summary>
+	/// Returns number of passes over fringe of last search.
+	/// </summary>
+	/// <returns>Number of passes</returns>
+	int getIterationCount() const { return m_iterationCount; }
+	/// <summary>
+	/// Check if last search stopped because transposition table was full
+	/// </summary>
+	/// <returns>True if memory budget was too small</returns>
+	bool isOutOfMemory() const { return m_isOutOfMemory; }
+	/// <summary>
+	/// Returns transposition table counters of last search.
+	/// </summary>
+	/// <returns>Table statistics</returns>
+	const TableStats& getTableStats() const { return m_table.getStats(); }
+	/// <summary>
+	/// Returns memory used by transposition table (fringe included).
+	/// </summary>
+	/// <returns>Size in bytes</returns>
+	std::size_t getMemoryUsage() const { return m_table.getMemoryUsage(); }
+private:
+	/// <summary>
+	/// Cell reached by search
+	/// </summary>
+	struct FringeNode
+	{
+		int distance;				//!< Lowest distance from start found
+		int previous;				//!< Slot of previous cell of fringe
+		int next;					//!< Slot of next cell of fringe
+		std::uint8_t direction;		//!< Direction code of move which reached the cell
+		bool isListed;				//!< Is cell in fringe
+	};
+	/// <summary>
+	/// Updates the solver by visiting one cell of fringe.
+	/// This method is called repeatedly until the algorithm finds the destination point or determines that no path exists.
+	/// </summary>
+	virtual void updateSolver() override;
+	/// <summary>
+	/// Updates the path after the algorithm has finished.
+	/// This method is called once the destination point has been reached
+	/// </summary>
+	virtual void updatePath() override;
+	/// <summary>
+	/// Runs Fringe Search until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Visits one cell of fringe.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepSolver();
+	/// <summary>
+	/// Put cell into fringe right after other cell
+	/// </summary>
+	/// <param name="slot">Slot of cell</param>
+	/// <param name="previous">Slot of cell already in fringe</param>
+	void link(int slot, int previous);
+	/// <summary>
+	/// Take cell out of fringe
+	/// </summary>
+	/// <param name="slot">Slot of cell</param>
+	void unlink(int slot);
+	/// <summary>
+	/// Record parents of path cells in search state, so path can be reconstructed
+	/// </summary>
+	/// <param name="slot">Slot of destination</param>
+	void storePath(int slot);
+	/// <summary>
+	/// Estimate remaining distance of cell (Chebyshev distance scaled by lowest cell weight)
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Admissible estimate</returns>
+	int estimate(int index) const;
+private:
+	TranspositionTable<FringeNode> m_table;	//!< Every reached cell with its fringe links (entries are never replaced)
+	int m_head{};							//!< Slot of first cell of fringe
+	int m_current{};						//!< Slot of cell visited next (NO_SLOT at end of pass)
+	int m_threshold{};						//!< Highest g + h of cells expanded in current pass
+	int m_nextThreshold{};					//!< Lowest g + h which exceeded threshold in current pass
+	int m_iterationCount{};					//!< Number of started passes
+	int m_minWeight{};						//!< Lowest cell weight on mesh
+	int m_finishRow{};						//!< Row of destination
+	int m_finishColumn{};					//!< Column of destination
+	bool m_isOutOfMemory{ false };			//!< Did search stop because table was full
+	bool m_isInitialised{ false };			//!< Was fringe seeded with start for current search
+};
\ No newline at end of file
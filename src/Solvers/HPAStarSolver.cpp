@@ -0,0 +1,700 @@
+#include "HPAStarSolver.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <unordered_map>
+
+////////////////////////////////////////////////////////////
+HPAStarSolver::HPAStarSolver(Mesh* mesh, int clusterSize, int threadCount)
+	: MeshSolver(mesh), m_threadPool(threadCount), m_clusterSize{ std::clamp(clusterSize, 4, MAX_CLUSTER_SIZE) }
+{
+	sf::Vector2i meshSize = mesh->getMeshSize();
+	m_clustersX = (meshSize.x + m_clusterSize - 1) / m_clusterSize;
+	m_clustersY = (meshSize.y + m_clusterSize - 1) / m_clusterSize;
+	m_perimeter = 4 * m_clusterSize - 4;
+	int clusterCount = m_clustersX * m_clustersY;
+	m_clusters.resize(clusterCount);
+	m_verticalBorders.resize(clusterCount);
+	m_horizontalBorders.resize(clusterCount);
+	m_corners.resize(clusterCount);
+	m_localSearches.resize(m_threadPool.getThreadCount());
+	for (LocalSearch& search : m_localSearches)
+	{
+		int cellCount = m_clusterSize * m_clusterSize;
+		search.heap.resize(cellCount);
+		search.distances.resize(cellCount);
+		search.parents.resize(cellCount);
+		search.stamps.assign(cellCount, 0);
+	}
+	// Start and destination get two extra nodes after perimeter nodes of all clusters
+	m_startNode = clusterCount * m_perimeter;
+	m_goalNode = m_startNode + 1;
+	m_nodeContainer.resize(m_goalNode + 1);
+	m_nodeDistances.resize(m_goalNode + 1);
+	m_nodeParents.resize(m_goalNode + 1);
+	m_nodeStamps.assign(m_goalNode + 1, 0);
+	reset();
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::reset()
+{
+	resetStartPosition();
+	resetSolver();
+}
+
+void HPAStarSolver::resetStartPosition()
+{
+	m_nodeContainer.clear();
+	m_isInitialised = false;
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::updateSolver()
+{
+	stepSolver<true>();
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::updatePath()
+{
+	stepParentPath<true>();
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::runSolver()
+{
+	while (!m_isFound && !m_isFinished)
+	{
+		stepSolver<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::runPath()
+{
+	while (!m_isFinished)
+	{
+		stepParentPath<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+int HPAStarSolver::getNodeCount() const
+{
+	int nodeCount = 0;
+	for (const Cluster& cluster : m_clusters)
+	{
+		nodeCount += static_cast<int>(cluster.nodes.size());
+	}
+	return nodeCount;
+}
+
+////////////////////////////////////////////////////////////
+template<bool Visualise>
+void HPAStarSolver::stepSolver()
+{
+	if (!m_isInitialised)
+	{
+		initialiseSearch();
+		m_isInitialised = true;
+	}
+	if (m_nodeContainer.empty())
+	{
+		m_isFinished = true;
+		return;
+	}
+	int node = m_nodeContainer.pop().first;
+	if (node == m_goalNode)
+	{
+		m_isFound = true;
+		refinePath();
+		return;
+	}
+	m_squareProcessed++;
+	int distance = m_nodeDistances[node];
+	if (node == m_startNode)
+	{
+		for (auto [nextNode, edgeDistance] : m_startEdges)
+		{
+			relaxNode(nextNode, distance + edgeDistance, node);
+		}
+	}
+	else
+	{
+		const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+		int clusterIndex = node / m_perimeter;
+		const Cluster& cluster = m_clusters[clusterIndex];
+		int nodeCount = static_cast<int>(cluster.nodes.size());
+		int local = static_cast<int>(std::lower_bound(cluster.nodes.begin(), cluster.nodes.end(), node % m_perimeter) - cluster.nodes.begin());
+		const std::uint16_t* distances = &cluster.distances[local * nodeCount];
+		for (int i = 0; i < nodeCount; ++i)
+		{
+			if (i != local && distances[i] != NO_DISTANCE)
+			{
+				relaxNode(clusterIndex * m_perimeter + cluster.nodes[i], distance + distances[i], node);
+			}
+		}
+		for (int i = cluster.linkStarts[local]; i < cluster.linkStarts[local + 1]; ++i)
+		{
+			relaxNode(getNode(cluster.links[i]), distance + cellWeights[cluster.links[i]], node);
+		}
+		if (clusterIndex == getCluster(m_mesh->getFinishPosition()) && m_goalDistances[local] != std::numeric_limits<int>::max())
+		{
+			relaxNode(m_goalNode, distance + m_goalDistances[local], node);
+		}
+		if constexpr (Visualise)
+		{
+			int index = getNodeCell(node);
+			if (m_mesh->getCellTypes()[index] == SquareType::EMPTY)
+			{
+				m_mesh->setCellColor(SquareType::PROCESSED, index);
+			}
+		}
+	}
+	if (m_nodeContainer.empty())
+	{
+		m_isFinished = true;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::initialiseSearch()
+{
+	updateAbstraction();
+	if (++m_nodeEpoch == 0)
+	{
+		std::fill(m_nodeStamps.begin(), m_nodeStamps.end(), 0);
+		m_nodeEpoch = 1;
+	}
+	m_nodeContainer.clear();
+	int startIndex = m_mesh->getStartPosition();
+	int finishIndex = m_mesh->getFinishPosition();
+	LocalSearch& search = m_localSearches.front();
+	search.processed = 0;
+	// Start is connected to nodes of its cluster (and directly to destination if it lies in the same cluster)
+	int startCluster = getCluster(startIndex);
+	searchCluster<false>(startIndex, -1, search);
+	m_startEdges.clear();
+	for (int position : m_clusters[startCluster].nodes)
+	{
+		int local = getLocalIndex(getPerimeterCell(startCluster, position));
+		if (search.stamps[local] == search.epoch)
+		{
+			m_startEdges.emplace_back(startCluster * m_perimeter + position, search.distances[local]);
+		}
+	}
+	if (getCluster(finishIndex) == startCluster && search.stamps[getLocalIndex(finishIndex)] == search.epoch)
+	{
+		m_startEdges.emplace_back(m_goalNode, search.distances[getLocalIndex(finishIndex)]);
+	}
+	// Nodes of destination cluster get distances to destination
+	int finishCluster = getCluster(finishIndex);
+	searchCluster<true>(finishIndex, -1, search);
+	m_goalDistances.clear();
+	for (int position : m_clusters[finishCluster].nodes)
+	{
+		int local = getLocalIndex(getPerimeterCell(finishCluster, position));
+		m_goalDistances.push_back(search.stamps[local] == search.epoch ? search.distances[local] : std::numeric_limits<int>::max());
+	}
+	m_squareProcessed += search.processed;
+	relaxNode(m_startNode, 0, -1);
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::relaxNode(int node, int distance, int parent)
+{
+	if (m_nodeStamps[node] == m_nodeEpoch && distance >= m_nodeDistances[node])
+	{
+		return;
+	}
+	m_nodeStamps[node] = m_nodeEpoch;
+	m_nodeDistances[node] = distance;
+	m_nodeParents[node] = parent;
+	int heuristic = 0;
+	if (node != m_goalNode && node != m_startNode)
+	{
+		// Every step costs at least MIN_CELL_WEIGHT and moves by one cell in Chebyshev metric, so estimate is consistent
+		sf::Vector2i meshSize = m_mesh->getMeshSize();
+		auto [row, column] = mapIndex2D(getNodeCell(node), meshSize.x);
+		auto [finishRow, finishColumn] = mapIndex2D(m_mesh->getFinishPosition(), meshSize.x);
+		heuristic = std::max(std::abs(finishRow - row), std::abs(finishColumn - column)) * Mesh::MIN_CELL_WEIGHT;
+	}
+	m_nodeContainer.push(node, distance + heuristic);
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::refinePath()
+{
+	sf::Vector2i meshSize = m_mesh->getMeshSize();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	SearchState& searchState = m_mesh->getSearchState();
+	int startIndex = m_mesh->getStartPosition();
+	int finishIndex = m_mesh->getFinishPosition();
+	// Cells of abstract path from destination to start
+	std::vector<int> waypoints;
+	for (int node = m_goalNode; node != -1; node = m_nodeParents[node])
+	{
+		waypoints.push_back(node == m_goalNode ? finishIndex : node == m_startNode ? startIndex : getNodeCell(node));
+	}
+	std::reverse(waypoints.begin(), waypoints.end());
+	LocalSearch& search = m_localSearches.front();
+	search.processed = 0;
+	std::vector<int> cells{ startIndex };
+	std::vector<int> segment;
+	for (size_t i = 1; i < waypoints.size(); ++i)
+	{
+		int from = waypoints[i - 1];
+		int to = waypoints[i];
+		if (from == to)
+		{
+			continue;
+		}
+		if (getCluster(from) != getCluster(to))
+		{
+			// Transition between neighbouring cells of two clusters
+			cells.push_back(to);
+			continue;
+		}
+		searchCluster<false>(from, to, search);
+		segment.clear();
+		for (int index = to; index != from; index = getParentIndex(index, search.parents[getLocalIndex(index)], meshSize.x))
+		{
+			segment.push_back(index);
+		}
+		cells.insert(cells.end(), segment.rbegin(), segment.rend());
+	}
+	m_squareProcessed += search.processed;
+	// Segments refined separately may cross each other, loops are cut so every cell has one parent
+	std::vector<int> path;
+	std::unordered_map<int, int> positions;
+	for (int index : cells)
+	{
+		auto it = positions.find(index);
+		if (it != positions.end())
+		{
+			while (path.size() > static_cast<size_t>(it->second) + 1)
+			{
+				positions.erase(path.back());
+				path.pop_back();
+			}
+			continue;
+		}
+		positions.emplace(index, static_cast<int>(path.size()));
+		path.push_back(index);
+	}
+	int distance = 0;
+	for (size_t i = 1; i < path.size(); ++i)
+	{
+		auto [row, column] = mapIndex2D(path[i], meshSize.x);
+		auto [previousRow, previousColumn] = mapIndex2D(path[i - 1], meshSize.x);
+		distance += cellWeights[path[i]];
+		searchState.visit(path[i], SquareType::PROCESSED);
+		searchState.setDistance(path[i], distance);
+		searchState.setParent(path[i], encodeDirection(row - previousRow, column - previousColumn));
+	}
+	beginPath(getParentIndex(finishIndex, searchState.getParent(finishIndex), meshSize.x));
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::updateAbstraction()
+{
+	if (!m_isBuilt || !m_mesh->getEditedCells(m_revision, m_editedCells))
+	{
+		buildAbstraction();
+		m_isBuilt = true;
+	}
+	else if (!m_editedCells.empty())
+	{
+		rebuildClusters(m_editedCells);
+	}
+	else
+	{
+		m_rebuiltClusters = 0;
+	}
+	m_revision = m_mesh->getRevision();
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::buildAbstraction()
+{
+	int clusterCount = static_cast<int>(m_clusters.size());
+	// Each cluster owns its right and lower border and corner block, so threads never write the same transitions
+	m_threadPool.parallelFor(clusterCount, 16, [this](int, int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				buildBorder(i, true);
+				buildBorder(i, false);
+				buildCorner(i);
+			}
+		});
+	m_threadPool.parallelFor(clusterCount, 4, [this](int threadIndex, int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				collectNodes(i);
+				computeDistances(i, m_localSearches[threadIndex]);
+			}
+		});
+	m_rebuiltClusters = clusterCount;
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::rebuildClusters(const std::vector<int>& cells)
+{
+	std::vector<int> editedClusters;
+	for (int index : cells)
+	{
+		editedClusters.push_back(getCluster(index));
+	}
+	std::sort(editedClusters.begin(), editedClusters.end());
+	editedClusters.erase(std::unique(editedClusters.begin(), editedClusters.end()), editedClusters.end());
+	// Transitions of edited cluster lie on its borders, which also hold nodes of its 8 neighbours
+	std::vector<int> affectedClusters;
+	for (int cluster : editedClusters)
+	{
+		int clusterRow = cluster / m_clustersX;
+		int clusterColumn = cluster % m_clustersX;
+		for (int i = std::max(clusterRow - 1, 0); i <= std::min(clusterRow + 1, m_clustersY - 1); ++i)
+		{
+			for (int j = std::max(clusterColumn - 1, 0); j <= std::min(clusterColumn + 1, m_clustersX - 1); ++j)
+			{
+				int neighbour = mapIndex1D(i, j, m_clustersX);
+				affectedClusters.push_back(neighbour);
+				if (i <= clusterRow && j <= clusterColumn)
+				{
+					buildCorner(neighbour);
+				}
+			}
+		}
+		buildBorder(cluster, true);
+		buildBorder(cluster, false);
+		if (clusterColumn > 0)
+		{
+			buildBorder(cluster - 1, true);
+		}
+		if (clusterRow > 0)
+		{
+			buildBorder(cluster - m_clustersX, false);
+		}
+	}
+	std::sort(affectedClusters.begin(), affectedClusters.end());
+	affectedClusters.erase(std::unique(affectedClusters.begin(), affectedClusters.end()), affectedClusters.end());
+	m_rebuiltClusters = 0;
+	for (int cluster : affectedClusters)
+	{
+		// Distances inside neighbour depend only on its own cells, they are recomputed only if its nodes moved
+		bool isNodeSetChanged = collectNodes(cluster);
+		if (isNodeSetChanged || std::binary_search(editedClusters.begin(), editedClusters.end(), cluster))
+		{
+			computeDistances(cluster, m_localSearches.front());
+			m_rebuiltClusters++;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::buildBorder(int cluster, bool isVertical)
+{
+	sf::Vector2i meshSize = m_mesh->getMeshSize();
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	std::vector<std::pair<int, int>>& transitions = isVertical ? m_verticalBorders[cluster] : m_horizontalBorders[cluster];
+	transitions.clear();
+	int clusterRow = cluster / m_clustersX;
+	int clusterColumn = cluster % m_clustersX;
+	if ((isVertical && clusterColumn + 1 >= m_clustersX) || (!isVertical && clusterRow + 1 >= m_clustersY))
+	{
+		return;
+	}
+	// Cells along border: first side belongs to this cluster, second one to its neighbour
+	int firstRow = clusterRow * m_clusterSize;
+	int firstColumn = clusterColumn * m_clusterSize;
+	int length = isVertical ? std::min(m_clusterSize, meshSize.y - firstRow) : std::min(m_clusterSize, meshSize.x - firstColumn);
+	int first = isVertical ? mapIndex1D(firstRow, firstColumn + m_clusterSize - 1, meshSize.x) : mapIndex1D(firstRow + m_clusterSize - 1, firstColumn, meshSize.x);
+	int across = isVertical ? 1 : meshSize.x;
+	int along = isVertical ? meshSize.x : 1;
+	auto isFree = [&](int index) { return cellTypes[index] != SquareType::FULL; };
+	auto isOpen = [&](int k) { return isFree(first + k * along) && isFree(first + k * along + across); };
+	int runStart = -1;
+	for (int k = 0; k <= length; ++k)
+	{
+		if (k < length && isOpen(k))
+		{
+			if (runStart == -1)
+			{
+				runStart = k;
+			}
+			continue;
+		}
+		if (runStart != -1)
+		{
+			// Short stretch is crossed in the middle, long one at both ends
+			int runEnd = k - 1;
+			if (runEnd - runStart + 1 <= MAX_SINGLE_TRANSITION)
+			{
+				int middle = first + (runStart + runEnd) / 2 * along;
+				transitions.emplace_back(middle, middle + across);
+			}
+			else
+			{
+				transitions.emplace_back(first + runStart * along, first + runStart * along + across);
+				transitions.emplace_back(first + runEnd * along, first + runEnd * along + across);
+			}
+			runStart = -1;
+		}
+	}
+	// Diagonal crossing needs own transition only where neither straight pair next to it is open
+	for (int k = 0; k + 1 < length; ++k)
+	{
+		if (isOpen(k) || isOpen(k + 1))
+		{
+			continue;
+		}
+		int cell = first + k * along;
+		if (isFree(cell) && isFree(cell + along + across))
+		{
+			transitions.emplace_back(cell, cell + along + across);
+		}
+		if (isFree(cell + along) && isFree(cell + across))
+		{
+			transitions.emplace_back(cell + along, cell + across);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::buildCorner(int cluster)
+{
+	sf::Vector2i meshSize = m_mesh->getMeshSize();
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	std::vector<std::pair<int, int>>& transitions = m_corners[cluster];
+	transitions.clear();
+	int clusterRow = cluster / m_clustersX;
+	int clusterColumn = cluster % m_clustersX;
+	if (clusterRow + 1 >= m_clustersY || clusterColumn + 1 >= m_clustersX)
+	{
+		return;
+	}
+	// Cells meeting at common corner of 2x2 block of clusters
+	int topLeft = mapIndex1D((clusterRow + 1) * m_clusterSize - 1, (clusterColumn + 1) * m_clusterSize - 1, meshSize.x);
+	int topRight = topLeft + 1;
+	int bottomLeft = topLeft + meshSize.x;
+	int bottomRight = bottomLeft + 1;
+	if (cellTypes[topLeft] != SquareType::FULL && cellTypes[bottomRight] != SquareType::FULL)
+	{
+		transitions.emplace_back(topLeft, bottomRight);
+	}
+	if (cellTypes[topRight] != SquareType::FULL && cellTypes[bottomLeft] != SquareType::FULL)
+	{
+		transitions.emplace_back(topRight, bottomLeft);
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool HPAStarSolver::collectNodes(int cluster)
+{
+	Cluster& data = m_clusters[cluster];
+	int clusterRow = cluster / m_clustersX;
+	int clusterColumn = cluster % m_clustersX;
+	// Node position and cell of other cluster entered from it (-1 if node has no link on this transition)
+	std::vector<std::pair<int, int>> endpoints;
+	auto addTransitions = [&](const std::vector<std::pair<int, int>>& transitions)
+		{
+			for (auto [first, second] : transitions)
+			{
+				if (getCluster(first) == cluster)
+				{
+					endpoints.emplace_back(getPerimeterPosition(first), isEnterable(second) ? second : -1);
+				}
+				else if (getCluster(second) == cluster)
+				{
+					endpoints.emplace_back(getPerimeterPosition(second), isEnterable(first) ? first : -1);
+				}
+			}
+		};
+	addTransitions(m_verticalBorders[cluster]);
+	addTransitions(m_horizontalBorders[cluster]);
+	if (clusterColumn > 0)
+	{
+		addTransitions(m_verticalBorders[cluster - 1]);
+	}
+	if (clusterRow > 0)
+	{
+		addTransitions(m_horizontalBorders[cluster - m_clustersX]);
+	}
+	for (int i = std::max(clusterRow - 1, 0); i <= clusterRow; ++i)
+	{
+		for (int j = std::max(clusterColumn - 1, 0); j <= clusterColumn; ++j)
+		{
+			addTransitions(m_corners[mapIndex1D(i, j, m_clustersX)]);
+		}
+	}
+	std::sort(endpoints.begin(), endpoints.end());
+	std::vector<int> nodes;
+	data.linkStarts.clear();
+	data.links.clear();
+	for (auto [position, link] : endpoints)
+	{
+		if (nodes.empty() || nodes.back() != position)
+		{
+			nodes.push_back(position);
+			data.linkStarts.push_back(static_cast<int>(data.links.size()));
+		}
+		if (link != -1)
+		{
+			data.links.push_back(link);
+		}
+	}
+	data.linkStarts.push_back(static_cast<int>(data.links.size()));
+	bool isChanged = nodes != data.nodes;
+	data.nodes = std::move(nodes);
+	return isChanged;
+}
+
+////////////////////////////////////////////////////////////
+void HPAStarSolver::computeDistances(int cluster, LocalSearch& search)
+{
+	Cluster& data = m_clusters[cluster];
+	int nodeCount = static_cast<int>(data.nodes.size());
+	data.distances.assign(static_cast<size_t>(nodeCount) * nodeCount, NO_DISTANCE);
+	for (int i = 0; i < nodeCount; ++i)
+	{
+		searchCluster<false>(getPerimeterCell(cluster, data.nodes[i]), -1, search);
+		for (int j = 0; j < nodeCount; ++j)
+		{
+			int local = getLocalIndex(getPerimeterCell(cluster, data.nodes[j]));
+			if (search.stamps[local] == search.epoch)
+			{
+				data.distances[i * nodeCount + j] = static_cast<std::uint16_t>(search.distances[local]);
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<bool Reverse>
+void HPAStarSolver::searchCluster(int source, int target, LocalSearch& search)
+{
+	sf::Vector2i meshSize = m_mesh->getMeshSize();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	if (++search.epoch == 0)
+	{
+		std::fill(search.stamps.begin(), search.stamps.end(), 0);
+		search.epoch = 1;
+	}
+	search.heap.clear();
+	auto [sourceRow, sourceColumn] = mapIndex2D(source, meshSize.x);
+	int firstRow = sourceRow / m_clusterSize * m_clusterSize;
+	int firstColumn = sourceColumn / m_clusterSize * m_clusterSize;
+	int rows = std::min(m_clusterSize, meshSize.y - firstRow);
+	int columns = std::min(m_clusterSize, meshSize.x - firstColumn);
+	int sourceLocal = getLocalIndex(source);
+	search.stamps[sourceLocal] = search.epoch;
+	search.distances[sourceLocal] = 0;
+	search.heap.push(sourceLocal, 0);
+	while (!search.heap.empty())
+	{
+		auto [local, distance] = search.heap.pop();
+		search.processed++;
+		int localRow = local / m_clusterSize;
+		int localColumn = local % m_clusterSize;
+		int index = mapIndex1D(firstRow + localRow, firstColumn + localColumn, meshSize.x);
+		if (index == target)
+		{
+			return;
+		}
+		for (auto [nextIndex, direction] : m_mesh->getNeighbours(index))
+		{
+			int nextRow = localRow + DIRECTION_ROW_OFFSET[direction];
+			int nextColumn = localColumn + DIRECTION_COL_OFFSET[direction];
+			if (nextRow < 0 || nextRow >= rows || nextColumn < 0 || nextColumn >= columns || !isEnterable(nextIndex))
+			{
+				continue;
+			}
+			// Reverse search walks moves backwards, so it pays weight of the cell it leaves
+			int nextDistance = distance + (Reverse ? cellWeights[index] : cellWeights[nextIndex]);
+			int nextLocal = mapIndex1D(nextRow, nextColumn, m_clusterSize);
+			if (search.stamps[nextLocal] == search.epoch && nextDistance >= search.distances[nextLocal])
+			{
+				continue;
+			}
+			search.stamps[nextLocal] = search.epoch;
+			search.distances[nextLocal] = nextDistance;
+			search.parents[nextLocal] = direction;
+			search.heap.push(nextLocal, nextDistance);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+int HPAStarSolver::getCluster(int index) const
+{
+	auto [row, column] = mapIndex2D(index, m_mesh->getMeshSize().x);
+	return mapIndex1D(row / m_clusterSize, column / m_clusterSize, m_clustersX);
+}
+
+////////////////////////////////////////////////////////////
+int HPAStarSolver::getPerimeterPosition(int index) const
+{
+	auto [row, column] = mapIndex2D(index, m_mesh->getMeshSize().x);
+	int localRow = row % m_clusterSize;
+	int localColumn = column % m_clusterSize;
+	// Top row, bottom row, then left and right column without corners
+	if (localRow == 0)
+	{
+		return localColumn;
+	}
+	if (localRow == m_clusterSize - 1)
+	{
+		return m_clusterSize + localColumn;
+	}
+	if (localColumn == 0)
+	{
+		return 2 * m_clusterSize + localRow - 1;
+	}
+	return 3 * m_clusterSize - 3 + localRow;
+}
+
+////////////////////////////////////////////////////////////
+int HPAStarSolver::getPerimeterCell(int cluster, int position) const
+{
+	int localRow;
+	int localColumn;
+	if (position < m_clusterSize)
+	{
+		localRow = 0;
+		localColumn = position;
+	}
+	else if (position < 2 * m_clusterSize)
+	{
+		localRow = m_clusterSize - 1;
+		localColumn = position - m_clusterSize;
+	}
+	else if (position < 3 * m_clusterSize - 2)
+	{
+		localRow = position - 2 * m_clusterSize + 1;
+		localColumn = 0;
+	}
+	else
+	{
+		localRow = position - 3 * m_clusterSize + 3;
+		localColumn = m_clusterSize - 1;
+	}
+	int row = cluster / m_clustersX * m_clusterSize + localRow;
+	int column = cluster % m_clustersX * m_clusterSize + localColumn;
+	return mapIndex1D(row, column, m_mesh->getMeshSize().x);
+}
+
+////////////////////////////////////////////////////////////
+int HPAStarSolver::getNodeCell(int node) const
+{
+	return getPerimeterCell(node / m_perimeter, node % m_perimeter);
+}
+
+////////////////////////////////////////////////////////////
+int HPAStarSolver::getLocalIndex(int index) const
+{
+	auto [row, column] = mapIndex2D(index, m_mesh->getMeshSize().x);
+	return mapIndex1D(row % m_clusterSize, column % m_clusterSize, m_clusterSize);
+}
\ No newline at end of file
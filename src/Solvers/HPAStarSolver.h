@@ -0,0 +1,232 @@
+#pragma once
+#include "MeshSolver.h"
+#include "src/Utility/IndexedHeap.h"
+#include "src/Utility/ThreadPool.h"
+#include <cstdint>
+#include <thread>
+
+/// <summary>
+/// A solver that uses hierarchical A* (HPA*) to find a path from a starting point to a destination point on a Mesh.
+/// Mesh is split into square clusters, cells where paths can cross cluster borders become nodes of an abstract graph
+/// and distances between nodes of each cluster are cached. Query searches the abstract graph and refines its edges into cells inside single clusters.
+/// Abstraction is kept between queries and only clusters around cells edited since last query are rebuilt.
+/// Path is near-optimal, its weight can be slightly higher than the one found by DjikstraSolver.
+/// </summary>
+class HPAStarSolver : public MeshSolver
+{
+public:
+	/// <summary>
+	/// Constructs an HPAStarSolver object that will operate on the given Mesh
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	/// <param name="clusterSize">Side of cluster in cells [4, MAX_CLUSTER_SIZE]</param>
+	/// <param name="threadCount">Number of threads building abstraction</param>
+	HPAStarSolver(Mesh* mesh, int clusterSize = DEFAULT_CLUSTER_SIZE, int threadCount = static_cast<int>(std::thread::hardware_concurrency()));
+	/// <summary>
+	/// Resets the solver to its initial state
+	/// </summary>
+	void reset() override;
+	/// <summary>
+	/// Reset starting position of solver;
+	/// </summary>
+	void resetStartPosition() override;
+	/// <summary>
+	/// Returns a string representing the name of the solver.
+	/// </summary>
+	/// <returns></returns>
+	std::string getSolverName() override { return "HPA* Solver"; }
+	/// <summary>
+	/// Bring abstraction up to date with mesh (done automatically before each search)
+	/// </summary>
+	void updateAbstraction();
+	/// <summary>
+	/// Get number of abstract nodes
+	/// </summary>
+	/// <returns>Number of nodes</returns>
+	int getNodeCount() const;
+	/// <summary>
+	/// Get number of clusters rebuilt by last abstraction update
+	/// </summary>
+	/// <returns>Number of clusters</returns>
+	int getRebuiltClusters() const { return m_rebuiltClusters; }
+	static constexpr int DEFAULT_CLUSTER_SIZE = 16;		//!< Default side of cluster
+private:
+	/// <summary>
+	/// Cached part of abstract graph inside one cluster
+	/// </summary>
+	struct Cluster
+	{
+		std::vector<int> nodes;					//!< Perimeter positions of node cells (sorted)
+		std::vector<std::uint16_t> distances;	//!< Distance from each node to each other node (row per source node)
+		std::vector<int> linkStarts;			//!< First link of each node (one more entry than nodes)
+		std::vector<int> links;					//!< Cells of other clusters which can be entered from node in one step
+	};
+	/// <summary>
+	/// Buffers of search limited to one cluster
+	/// </summary>
+	struct LocalSearch
+	{
+		IndexedHeap<int> heap;				//!< Cells waiting for expansion (local indexes)
+		std::vector<int> distances;			//!< Distance of each cell of cluster
+		std::vector<std::uint8_t> parents;	//!< Direction code of move which reached each cell
+		std::vector<std::uint32_t> stamps;	//!< Search in which cell was reached
+		std::uint32_t epoch{};				//!< Current search
+		int processed{};					//!< Number of expanded cells
+	};
+	/// <summary>
+	/// Updates the solver by expanding one abstract node.
+	/// This method is called repeatedly until the algorithm finds the destination point or determines that no path exists.
+	/// </summary>
+	virtual void updateSolver() override;
+	/// <summary>
+	/// Updates the path after the algorithm has finished.
+	/// This method is called once the destination point has been reached
+	/// </summary>
+	virtual void updatePath() override;
+	/// <summary>
+	/// Runs the HPA* algorithm until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Expands one abstract node.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed nodes should be coloured</typeparam>
+	template<bool Visualise>
+	void stepSolver();
+	/// <summary>
+	/// Connect starting point and destination to nodes of their clusters
+	/// </summary>
+	void initialiseSearch();
+	/// <summary>
+	/// Lower distance of abstract node and queue it if given distance is shorter
+	/// </summary>
+	/// <param name="node">Abstract node</param>
+	/// <param name="distance">New distance</param>
+	/// <param name="parent">Node from which it was reached</param>
+	void relaxNode(int node, int distance, int parent);
+	/// <summary>
+	/// Turn abstract path into cells and store distances and parents of path cells in search state
+	/// </summary>
+	void refinePath();
+	/// <summary>
+	/// Rebuild transitions and cached distances of all clusters
+	/// </summary>
+	void buildAbstraction();
+	/// <summary>
+	/// Rebuild clusters holding given cells and clusters sharing border with them
+	/// </summary>
+	/// <param name="cells">Edited cells</param>
+	void rebuildClusters(const std::vector<int>& cells);
+	/// <summary>
+	/// Find transitions across border between two clusters
+	/// </summary>
+	/// <param name="cluster">Cluster above or left of border</param>
+	/// <param name="isVertical">True for border with cluster on the right, false for border with cluster below</param>
+	void buildBorder(int cluster, bool isVertical);
+	/// <summary>
+	/// Find transitions across corners of 2x2 block of clusters
+	/// </summary>
+	/// <param name="cluster">Top left cluster of block</param>
+	void buildCorner(int cluster);
+	/// <summary>
+	/// Collect nodes and links of cluster from transitions on its borders and corners
+	/// </summary>
+	/// <param name="cluster">Cluster</param>
+	/// <returns>True if set of nodes changed</returns>
+	bool collectNodes(int cluster);
+	/// <summary>
+	/// Compute distances between all nodes of cluster
+	/// </summary>
+	/// <param name="cluster">Cluster</param>
+	/// <param name="search">Search buffers of calling thread</param>
+	void computeDistances(int cluster, LocalSearch& search);
+	/// <summary>
+	/// Run Djikstra search from cell limited to cells of its cluster
+	/// </summary>
+	/// <typeparam name="Reverse">Search distances to source instead of distances from it</typeparam>
+	/// <param name="source">Index of source cell</param>
+	/// <param name="target">Index of cell at which search stops (-1 to reach whole cluster)</param>
+	/// <param name="search">Search buffers</param>
+	template<bool Reverse>
+	void searchCluster(int source, int target, LocalSearch& search);
+	/// <summary>
+	/// Check if cell can be entered by path
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>True if cell is empty or destination</returns>
+	bool isEnterable(int index) const
+	{
+		SquareType type = m_mesh->getCellTypes()[index];
+		return type == SquareType::EMPTY || type == SquareType::FINISH;
+	}
+	/// <summary>
+	/// Get cluster containing cell
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Index of cluster</returns>
+	int getCluster(int index) const;
+	/// <summary>
+	/// Get position of cell on perimeter of its cluster
+	/// </summary>
+	/// <param name="index">Index of cell lying on cluster border</param>
+	/// <returns>Perimeter position</returns>
+	int getPerimeterPosition(int index) const;
+	/// <summary>
+	/// Get cell at perimeter position of cluster
+	/// </summary>
+	/// <param name="cluster">Index of cluster</param>
+	/// <param name="position">Perimeter position</param>
+	/// <returns>Index of cell</returns>
+	int getPerimeterCell(int cluster, int position) const;
+	/// <summary>
+	/// Get abstract node placed on cell
+	/// </summary>
+	/// <param name="index">Index of cell lying on cluster border</param>
+	/// <returns>Abstract node</returns>
+	int getNode(int index) const { return getCluster(index) * m_perimeter + getPerimeterPosition(index); }
+	/// <summary>
+	/// Get cell of abstract node
+	/// </summary>
+	/// <param name="node">Abstract node</param>
+	/// <returns>Index of cell</returns>
+	int getNodeCell(int node) const;
+	/// <summary>
+	/// Get index of cell in cluster it belongs to
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Local index</returns>
+	int getLocalIndex(int index) const;
+private:
+	static constexpr int MAX_CLUSTER_SIZE = 64;			//!< Largest side of cluster for which cached distances fit 16 bits
+	static constexpr int MAX_SINGLE_TRANSITION = 5;		//!< Longest free stretch of border crossed by single transition (longer ones get transition at both ends)
+	static constexpr std::uint16_t NO_DISTANCE = 0xFFFF;	//!< Cached distance of unreachable node
+	ThreadPool m_threadPool;					//!< Threads building abstraction
+	int m_clusterSize;							//!< Side of cluster
+	int m_clustersX;							//!< Number of clusters in row
+	int m_clustersY;							//!< Number of clusters in column
+	int m_perimeter;							//!< Number of perimeter positions of cluster
+	std::vector<Cluster> m_clusters;			//!< Cached abstract graph of each cluster
+	std::vector<std::vector<std::pair<int, int>>> m_verticalBorders;	//!< Transitions (left cell, right cell) between each cluster and its right neighbour
+	std::vector<std::vector<std::pair<int, int>>> m_horizontalBorders;	//!< Transitions (upper cell, lower cell) between each cluster and neighbour below
+	std::vector<std::vector<std::pair<int, int>>> m_corners;			//!< Diagonal transitions in 2x2 block of clusters starting at each cluster
+	std::vector<LocalSearch> m_localSearches;	//!< Search buffers of each thread
+	std::vector<int> m_editedCells;				//!< Cells edited since last abstraction update
+	std::uint32_t m_revision{};					//!< Mesh revision of abstraction
+	bool m_isBuilt{ false };					//!< Was abstraction built at least once
+	int m_rebuiltClusters{};					//!< Number of clusters rebuilt by last update
+	// Query
+	IndexedHeap<int> m_nodeContainer;			//!< The priority queue of abstract nodes and their estimated path lengths
+	std::vector<int> m_nodeDistances;			//!< Distance of each abstract node from start
+	std::vector<int> m_nodeParents;				//!< Node from which each abstract node was reached
+	std::vector<std::uint32_t> m_nodeStamps;	//!< Query in which node was reached
+	std::uint32_t m_nodeEpoch{};				//!< Current query
+	std::vector<std::pair<int, int>> m_startEdges;	//!< Nodes reachable from start inside its cluster and their distances
+	std::vector<int> m_goalDistances;			//!< Distance from each node of destination cluster to destination
+	int m_startNode{};							//!< Abstract node of starting point
+	int m_goalNode{};							//!< Abstract node of destination
+	bool m_isInitialised{ false };				//!< Were start and destination connected to abstract graph
+};
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "IDAStarSolver.h"
+#include "SearchPolicies.h"
+#include <climits>
+#include <cstdlib>
+
+////////////////////////////////////////////////////////////
+IDAStarSolver::IDAStarSolver(Mesh* mesh, std::size_t tableMegabytes) : MeshSolver(mesh)
+{
+	m_table.resize(tableMegabytes);
+	reset();
+}
+
+////////////////////////////////////////////////////////////
+void IDAStarSolver::reset()
+{
+	resetStartPosition();
+	resetSolver();
+}
+
+void IDAStarSolver::resetStartPosition()
+{
+	m_stack.clear();
+	m_bestPath.clear();
+	m_iterationCount = 0;
+	m_isInitialised = false;
+}
+
+////////////////////////////////////////////////////////////
+void IDAStarSolver::updateSolver()
+{
+	stepSolver<true>();
+}
+
+////////////////////////////////////////////////////////////
+void IDAStarSolver::updatePath()
+{
+	stepParentPath<true>();
+}
+
+////////////////////////////////////////////////////////////
+void IDAStarSolver::runSolver()
+{
+	while (!m_isFound && !m_isFinished)
+	{
+		stepSolver<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void IDAStarSolver::runPath()
+{
+	while (!m_isFinished)
+	{
+		stepParentPath<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<bool Visualise>
+void IDAStarSolver::stepSolver()
+{
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	if (!m_isInitialised)
+	{
+		m_minWeight = m_mesh->getMinCellWeight();
+		auto [finishRow, finishColumn] = mapIndex2D(m_mesh->getFinishPosition(), m_mesh->getMeshSize().x);
+		m_finishRow = finishRow;
+		m_finishColumn = finishColumn;
+		// Backed-up estimates are valid only for current mesh and destination
+		m_table.clear();
+		m_initialThreshold = estimate(m_mesh->getStartPosition());
+		beginIteration(m_initialThreshold);
+		m_isInitialised = true;
+	}
+	if (m_stack.empty())
+	{
+		// Every cell within threshold was tried, path found in this iteration is optimal
+		if (m_bestDistance != INT_MAX)
+		{
+			m_isFound = true;
+			storePath();
+			return;
+		}
+		if (m_nextThreshold == INT_MAX)
+		{
+			m_isFinished = true;
+			return;
+		}
+		beginIteration(getNextThreshold());
+	}
+	Frame& frame = m_stack.back();
+	if (!frame.mask)
+	{
+		popFrame();
+		return;
+	}
+	std::uint8_t direction = NEIGHBOUR_DIRECTIONS[countTrailingZeros(frame.mask)];
+	frame.mask &= frame.mask - 1;
+	int nextIndex = frame.index + DIRECTION_ROW_OFFSET[direction] * m_mesh->getMeshSize().x + DIRECTION_COL_OFFSET[direction];
+	if (cellTypes[nextIndex] != SquareType::EMPTY && cellTypes[nextIndex] != SquareType::FINISH)
+	{
+		return;
+	}
+	int moveCost = cellWeights[nextIndex];
+	int nextDistance = frame.distance + moveCost;
+	int slot = m_table.find(nextIndex);
+	int nextEstimate = cellTypes[nextIndex] == SquareType::FINISH ? 0 : estimate(nextIndex, slot);
+	if (nextEstimate == INT_MAX)
+	{
+		// Every neighbour of cell except start was tried and none leads to destination
+		return;
+	}
+	if (nextDistance + nextEstimate > m_threshold)
+	{
+		frame.bound = std::min(frame.bound, moveCost + nextEstimate);
+		m_nextThreshold = std::min(m_nextThreshold, nextDistance + nextEstimate);
+		return;
+	}
+	if (cellTypes[nextIndex] == SquareType::FINISH)
+	{
+		// Limit may have overshot optimal weight, keep searching only for cheaper paths
+		frame.bound = std::min(frame.bound, moveCost);
+		m_bestDistance = nextDistance;
+		m_bestPath = m_stack;
+		m_threshold = nextDistance - 1;
+		return;
+	}
+	// Cell entered earlier in this iteration with no larger distance already had its subtree tried
+	if (slot != m_table.NO_SLOT && m_table.getValue(slot).iteration == m_iterationCount && m_table.getValue(slot).distance <= nextDistance)
+	{
+		frame.bound = std::min(frame.bound, moveCost + nextEstimate);
+		return;
+	}
+	if (slot == m_table.NO_SLOT)
+	{
+		slot = m_table.insert(nextIndex, [this](const TableEntry& entry) { return getVictimScore(entry); });
+		m_table.getValue(slot).estimate = nextEstimate;
+	}
+	m_table.getValue(slot).distance = nextDistance;
+	m_table.getValue(slot).iteration = m_iterationCount;
+	m_stack.push_back(Frame{ nextIndex, nextDistance, INT_MAX, m_mesh->getNeighbourMask(nextIndex), direction });
+	m_squareProcessed++;
+	if constexpr (Visualise)
+	{
+		// Cells are entered again in every iteration, colour them once
+		SearchState& searchState = m_mesh->getSearchState();
+		if (!searchState.isVisited(nextIndex))
+		{
+			searchState.visit(nextIndex, SquareType::PROCESSED);
+			m_mesh->setCellColor(SquareType::PROCESSED, nextIndex);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void IDAStarSolver::beginIteration(int threshold)
+{
+	int startIndex = m_mesh->getStartPosition();
+	m_threshold = threshold;
+	m_nextThreshold = INT_MAX;
+	m_bestDistance = INT_MAX;
+	m_iterationCount++;
+	int slot = m_table.find(startIndex);
+	if (slot == m_table.NO_SLOT)
+	{
+		slot = m_table.insert(startIndex, [this](const TableEntry& entry) { return getVictimScore(entry); });
+		m_table.getValue(slot).estimate = estimate(startIndex);
+	}
+	m_table.getValue(slot).distance = 0;
+	m_table.getValue(slot).iteration = m_iterationCount;
+	m_stack.clear();
+	m_stack.push_back(Frame{ startIndex, 0, INT_MAX, m_mesh->getNeighbourMask(startIndex), 0 });
+}
+
+////////////////////////////////////////////////////////////
+int IDAStarSolver::getNextThreshold() const
+{
+	// Growing excess over estimate of start geometrically bounds number of iterations on weighted meshes, where every lightest move raises g + h
+	return std::max(m_nextThreshold, m_threshold + std::max(m_minWeight, m_threshold - m_initialThreshold));
+}
+
+////////////////////////////////////////////////////////////
+void IDAStarSolver::popFrame()
+{
+	Frame frame = m_stack.back();
+	m_stack.pop_back();
+	// Every path to destination leaves cell through one of its neighbours, so lowest move cost plus estimate is admissible
+	int backedUp = frame.bound;
+	int slot = m_table.find(frame.index);
+	if (slot != m_table.NO_SLOT)
+	{
+		TableEntry& entry = m_table.getValue(slot);
+		entry.estimate = std::max(entry.estimate, backedUp);
+		backedUp = entry.estimate;
+	}
+	if (!m_stack.empty() && backedUp != INT_MAX)
+	{
+		Frame& parent = m_stack.back();
+		parent.bound = std::min(parent.bound, m_mesh->getCellWeights()[frame.index] + backedUp);
+	}
+}
+
+////////////////////////////////////////////////////////////
+int IDAStarSolver::getVictimScore(const TableEntry& entry) const
+{
+	// Entries of earlier iterations only keep estimates, entries of current one also prune duplicate branches
+	return entry.iteration != m_iterationCount ? INT_MAX : entry.distance;
+}
+
+////////////////////////////////////////////////////////////
+void IDAStarSolver::storePath()
+{
+	SearchState& searchState = m_mesh->getSearchState();
+	for (size_t i = 1; i < m_bestPath.size(); ++i)
+	{
+		searchState.visit(m_bestPath[i].index, SquareType::PROCESSED);
+		searchState.setDistance(m_bestPath[i].index, m_bestPath[i].distance);
+		searchState.setParent(m_bestPath[i].index, m_bestPath[i].direction);
+	}
+	beginPath(m_bestPath.back().index, m_minWeight);
+}
+
+////////////////////////////////////////////////////////////
+int IDAStarSolver::estimate(int index) const
+{
+	auto [row, column] = mapIndex2D(index, m_mesh->getMeshSize().x);
+	return ChebyshevHeuristic::estimate(std::abs(row - m_finishRow), std::abs(column - m_finishColumn), m_minWeight, m_minWeight);
+}
+
+////////////////////////////////////////////////////////////
+int IDAStarSolver::estimate(int index, int slot)
+{
+	int heuristic = estimate(index);
+	return slot == m_table.NO_SLOT ? heuristic : std::max(heuristic, m_table.getValue(slot).estimate);
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#pragma once
+#include "MeshSolver.h"
+#include "src/Utility/TranspositionTable.h"
+
+/// <summary>
+/// A solver that uses the IDA* algorithm to find the shortest path from a starting point to a destination point on a Mesh.
+/// Depth-first iterations are bounded by growing limit of g + h. Excess of limit over estimate of start is doubled every iteration,
+/// and first found path only lowers limit of last iteration until it is proven optimal.
+/// Open list is replaced by explicit stack of current branch
+/// and transposition table of fixed size, so memory does not grow with explored area (stack holds one frame per cell of current branch).
+/// Table prunes cells already entered in iteration with no larger distance and keeps estimates backed up from finished subtrees
+/// between iterations, so next iteration does not enter subtrees which are known to exceed its limit.
+/// When table is full, entries of earlier iterations and then of cells farthest from start are replaced, which costs extra expansions, but never correctness
+/// (table much smaller than cells entered in one iteration loses most duplicate pruning, so number of expansions grows quickly).
+/// </summary>
+class IDAStarSolver : public MeshSolver
+{
+public:
+	static constexpr std::size_t DEFAULT_TABLE_MEGABYTES = 16;	//!< Default memory budget of transposition table
+	/// <summary>
+	/// Constructs an IDAStarSolver object that will operate on the given Mesh
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	/// <param name="tableMegabytes">Memory budget of transposition table</param>
+	IDAStarSolver(Mesh* mesh, std::size_t tableMegabytes = DEFAULT_TABLE_MEGABYTES);
+	/// <summary>
+	/// Resets the solver to its initial state
+	/// </summary>
+	void reset() override;
+	/// <summary>
+	/// Reset starting position of solver;
+	/// </summary>
+	void resetStartPosition() override;
+	/// <summary>
+	/// Returns a string representing the name of the solver.
+	/// </summary>
+	/// <returns></returns>
+	std::string getSolverName() override { return "IDA* Solver"; }
+	/// <summary>
+	/// Returns number of depth-first iterations of last search.
+	/// </summary>
+	/// <returns>Number of iterations</returns>
+	int getIterationCount() const { return m_iterationCount; }
+	/// <summary>
+	/// Returns transposition table counters of last search.
+	/// </summary>
+	/// <returns>Table statistics</returns>
+	const TableStats& getTableStats() const { return m_table.getStats(); }
+	/// <summary>
+	/// Returns memory used by transposition table and search stack.
+	/// </summary>
+	/// <returns>Size in bytes</returns>
+	std::size_t getMemoryUsage() const { return m_table.getMemoryUsage() + (m_stack.capacity() + m_bestPath.capacity()) * sizeof(Frame); }
+private:
+	/// <summary>
+	/// Transposition table entry of cell
+	/// </summary>
+	struct TableEntry
+	{
+		int distance;				//!< Lowest distance with which cell was entered in iteration
+		int iteration;				//!< Iteration in which distance was stored
+		int estimate;				//!< Backed-up estimate of remaining distance (never lower than heuristic)
+	};
+	/// <summary>
+	/// Cell of current branch
+	/// </summary>
+	struct Frame
+	{
+		int index;					//!< Index of cell
+		int distance;				//!< Distance from start along branch
+		int bound;					//!< Lowest cost of move plus estimate over neighbours tried so far
+		std::uint8_t mask;			//!< Neighbour slots not yet tried
+		std::uint8_t direction;		//!< Direction code of move which reached the cell
+	};
+	/// <summary>
+	/// Updates the solver by trying one move of the IDA* algorithm.
+	/// This method is called repeatedly until the algorithm finds the destination point or determines that no path exists.
+	/// </summary>
+	virtual void updateSolver() override;
+	/// <summary>
+	/// Updates the path after the algorithm has finished.
+	/// This method is called once the destination point has been reached
+	/// </summary>
+	virtual void updatePath() override;
+	/// <summary>
+	/// Runs the IDA* algorithm until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Tries one move from top of stack of the IDA* algorithm.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepSolver();
+	/// <summary>
+	/// Start depth-first iteration from start cell
+	/// </summary>
+	/// <param name="threshold">Highest g + h of cells entered in iteration</param>
+	void beginIteration(int threshold);
+	/// <summary>
+	/// Choose limit of next iteration
+	/// </summary>
+	/// <returns>Highest g + h of cells entered in next iteration</returns>
+	int getNextThreshold() const;
+	/// <summary>
+	/// Leave cell on top of stack and back up its estimate to table and to its parent
+	/// </summary>
+	void popFrame();
+	/// <summary>
+	/// Get priority of table entry for replacement when table is full
+	/// </summary>
+	/// <param name="entry">Table entry</param>
+	/// <returns>Victim score (highest is replaced first)</returns>
+	int getVictimScore(const TableEntry& entry) const;
+	/// <summary>
+	/// Record best found branch as parents in search state, so path can be reconstructed
+	/// </summary>
+	void storePath();
+	/// <summary>
+	/// Estimate remaining distance of cell (Chebyshev distance scaled by lowest cell weight)
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Admissible estimate</returns>
+	int estimate(int index) const;
+	/// <summary>
+	/// Estimate remaining distance of cell, raised by backed-up estimate from table
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <param name="slot">Slot of cell in table (NO_SLOT if cell is not stored)</param>
+	/// <returns>Admissible estimate</returns>
+	int estimate(int index, int slot);
+private:
+	TranspositionTable<TableEntry> m_table;	//!< Distances of current iteration and backed-up estimates of cells
+	std::vector<Frame> m_stack;			//!< Cells of current branch, from start
+	std::vector<Frame> m_bestPath;		//!< Branch of cheapest path found in last iteration
+	int m_threshold{};					//!< Highest g + h of cells entered in current iteration (lowered below weight of found path)
+	int m_initialThreshold{};			//!< Estimate of start (threshold of first iteration)
+	int m_nextThreshold{};				//!< Lowest g + h which exceeded threshold in current iteration
+	int m_bestDistance{};				//!< Weight of cheapest path found in current iteration (INT_MAX if none)
+	int m_iterationCount{};				//!< Number of started iterations
+	int m_minWeight{};					//!< Lowest cell weight on mesh
+	int m_finishRow{};					//!< Row of destination
+	int m_finishColumn{};				//!< Column of destination
+	bool m_isInitialised{ false };		//!< Were estimate parameters brought up to date for current search
+};
\ No newline at end of file
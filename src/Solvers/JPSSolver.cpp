@@ -0,0 +1,429 @@
+#include "JPSSolver.h"
+#include <algorithm>
+#include <limits>
+#include <cstdlib>
+#include <tuple>
+
+namespace
+{
+	/// <summary>
+	/// Row offsets of directions (straight directions first)
+	/// </summary>
+	constexpr int JUMP_ROW[8] = { -1, 1, 0, 0, -1, -1, 1, 1 };
+	/// <summary>
+	/// Column offsets of directions (straight directions first)
+	/// </summary>
+	constexpr int JUMP_COL[8] = { 0, 0, -1, 1, -1, 1, -1, 1 };
+	/// <summary>
+	/// Index of direction for each direction code (-1 for no move)
+	/// </summary>
+	constexpr int DIRECTION_SLOT[9] = { 4, 0, 5, 2, -1, 3, 6, 1, 7 };
+	/// <summary>
+	/// Mask with all 8 directions set
+	/// </summary>
+	constexpr std::uint8_t ALL_DIRECTIONS = 0xFF;
+	/// <summary>
+	/// Longest jump which can be stored in jump table
+	/// </summary>
+	constexpr std::int16_t MAX_JUMP = std::numeric_limits<std::int16_t>::max();
+
+	/// <summary>
+	/// Get bit of direction in direction mask
+	/// </summary>
+	/// <param name="rowDir">Row offset of move [-1,1]</param>
+	/// <param name="colDir">Column offset of move [-1,1]</param>
+	/// <returns>Direction bit</returns>
+	inline std::uint8_t directionBit(int rowDir, int colDir)
+	{
+		return static_cast<std::uint8_t>(1 << DIRECTION_SLOT[encodeDirection(rowDir, colDir)]);
+	}
+}
+
+////////////////////////////////////////////////////////////
+JPSSolver::JPSSolver(Mesh* mesh, JPSMode mode) : MeshSolver(mesh), m_mode{ mode }
+{
+	m_cellContainer.resize(mesh->getCellCount());
+	reset();
+}
+
+////////////////////////////////////////////////////////////
+void JPSSolver::reset()
+{
+	resetStartPosition();
+	resetSolver();
+}
+
+void JPSSolver::resetStartPosition()
+{
+	m_cellContainer.clear();
+	m_cellContainer.push(m_mesh->getStartPosition(), 0);
+}
+
+////////////////////////////////////////////////////////////
+void JPSSolver::updateSolver()
+{
+	updateGridData();
+	stepSolver<true>();
+}
+
+////////////////////////////////////////////////////////////
+void JPSSolver::updatePath()
+{
+	stepJumpPath<true>();
+}
+
+////////////////////////////////////////////////////////////
+void JPSSolver::runSolver()
+{
+	updateGridData();
+	while (!m_isFound && !m_isFinished)
+	{
+		stepSolver<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void JPSSolver::runPath()
+{
+	while (!m_isFinished)
+	{
+		stepJumpPath<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<bool Visualise>
+void JPSSolver::stepSolver()
+{
+	sf::Vector2i meshSize = m_mesh->getMeshSize();
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	SearchState& searchState = m_mesh->getSearchState();
+	std::tie(m_finishRow, m_finishColumn) = mapIndex2D(m_mesh->getFinishPosition(), meshSize.x);
+	int topIndex = m_cellContainer.pop().first;
+
+	// Distance to destination is final only once it leaves the queue
+	if (cellTypes[topIndex] == SquareType::FINISH)
+	{
+		m_isFound = true;
+		m_pathDirection = searchState.getParent(topIndex);
+		m_pathIndex = getParentIndex(topIndex, m_pathDirection, meshSize.x);
+		m_pathDistance = searchState.getDistance(topIndex) - cellWeights[topIndex];
+		// Every step costs at least 1 so distance bounds number of path cells
+		m_path.reserve(m_pathDistance + 1);
+		return;
+	}
+	m_squareProcessed++;
+	int topDistance = searchState.getDistance(topIndex);
+	auto [row, column] = mapIndex2D(topIndex, meshSize.x);
+	std::uint8_t directions = ALL_DIRECTIONS;
+	if (m_isUniform && cellTypes[topIndex] != SquareType::START)
+	{
+		directions = getSuccessorDirections(row, column, searchState.getParent(topIndex));
+	}
+	for (int direction = 0; direction < 8; ++direction)
+	{
+		if (!(directions & (1 << direction)))
+		{
+			continue;
+		}
+		int rowDir = JUMP_ROW[direction];
+		int colDir = JUMP_COL[direction];
+		int steps;
+		if (!m_isUniform)
+		{
+			steps = isWalkable(row + rowDir, column + colDir) ? 1 : 0;
+		}
+		else if (m_mode == JPSMode::PRECOMPUTED)
+		{
+			steps = jumpPrecomputed(row, column, direction);
+		}
+		else
+		{
+			steps = jump(row, column, rowDir, colDir);
+		}
+		if (steps == 0)
+		{
+			continue;
+		}
+		int nextRow = row + rowDir * steps;
+		int nextColumn = column + colDir * steps;
+		int nextIndex = mapIndex1D(nextRow, nextColumn, meshSize.x);
+		int nextDistance = topDistance + (m_isUniform ? steps * m_stepWeight : cellWeights[nextIndex]);
+		if (!searchState.isVisited(nextIndex))
+		{
+			searchState.visit(nextIndex, SquareType::QUEUED);
+			if constexpr (Visualise)
+			{
+				if (cellTypes[nextIndex] == SquareType::EMPTY)
+				{
+					m_mesh->setCellColor(SquareType::QUEUED, nextIndex);
+				}
+			}
+		}
+		// Relax only cells still waiting in queue and only if new distance is shorter
+		else if (searchState.getState(nextIndex) != SquareType::QUEUED || nextDistance >= searchState.getDistance(nextIndex))
+		{
+			continue;
+		}
+		searchState.setDistance(nextIndex, nextDistance);
+		searchState.setParent(nextIndex, encodeDirection(rowDir, colDir));
+		// Diagonal step costs the same as straight one, so Chebyshev distance is admissible
+		int heuristic = std::max(std::abs(m_finishRow - nextRow), std::abs(m_finishColumn - nextColumn)) * m_stepWeight;
+		m_cellContainer.push(nextIndex, nextDistance + heuristic);
+	}
+	// Mark current Cell as finished
+	if (cellTypes[topIndex] != SquareType::START)
+	{
+		searchState.setState(topIndex, SquareType::PROCESSED);
+		if constexpr (Visualise)
+		{
+			m_mesh->setCellColor(SquareType::PROCESSED, topIndex);
+		}
+	}
+	if (m_cellContainer.empty())
+	{
+		m_isFinished = true;
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<bool Visualise>
+void JPSSolver::stepJumpPath()
+{
+	SearchState& searchState = m_mesh->getSearchState();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	int index = m_pathIndex;
+	m_pathLength++;
+	m_pathWeight += cellWeights[index];
+	if (m_pathDistance == 0)
+	{
+		m_isFinished = true;
+		return;
+	}
+	// Any visited cell with matching distance has valid parent chain, so it can be used as next segment start
+	if (searchState.isVisited(index) && searchState.getDistance(index) == m_pathDistance)
+	{
+		m_pathDirection = searchState.getParent(index);
+	}
+	else
+	{
+		searchState.visit(index, SquareType::PATH);
+		searchState.setDistance(index, m_pathDistance);
+		searchState.setParent(index, m_pathDirection);
+	}
+	searchState.setState(index, SquareType::PATH);
+	m_path.push_back(index);
+	if constexpr (Visualise)
+	{
+		m_mesh->setCellColor(SquareType::PATH, index);
+	}
+	m_pathDistance -= cellWeights[index];
+	m_pathIndex = getParentIndex(index, m_pathDirection, m_mesh->getMeshSize().x);
+}
+
+////////////////////////////////////////////////////////////
+void JPSSolver::updateGridData()
+{
+	if (m_isGridDataValid && m_gridRevision == m_mesh->getRevision())
+	{
+		return;
+	}
+	m_isGridDataValid = true;
+	m_gridRevision = m_mesh->getRevision();
+	// Jumping over cells is valid only if every step costs the same
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	const std::vector<std::uint8_t>& cellWeights = m_mesh->getCellWeights();
+	int stepWeight = -1;
+	m_isUniform = true;
+	for (int i = 0; i < m_mesh->getCellCount(); ++i)
+	{
+		if (cellTypes[i] != SquareType::EMPTY && cellTypes[i] != SquareType::FINISH)
+		{
+			continue;
+		}
+		if (stepWeight == -1)
+		{
+			stepWeight = cellWeights[i];
+		}
+		else if (cellWeights[i] != stepWeight)
+		{
+			m_isUniform = false;
+			break;
+		}
+	}
+	m_stepWeight = m_isUniform && stepWeight != -1 ? stepWeight : Mesh::MIN_CELL_WEIGHT;
+	if (m_isUniform && m_mode == JPSMode::PRECOMPUTED)
+	{
+		buildJumpTable();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void JPSSolver::buildJumpTable()
+{
+	sf::Vector2i meshSize = m_mesh->getMeshSize();
+	m_jumpTable.resize(static_cast<size_t>(m_mesh->getCellCount()) * 8);
+	// Straight directions go first, diagonal jumps stop where straight ones find jump point
+	for (int direction = 0; direction < 8; ++direction)
+	{
+		int rowDir = JUMP_ROW[direction];
+		int colDir = JUMP_COL[direction];
+		bool isDiagonal = rowDir != 0 && colDir != 0;
+		// Visit cells so that next cell in direction is always computed first
+		int rowStart = rowDir > 0 ? meshSize.y - 1 : 0;
+		int rowStep = rowDir > 0 ? -1 : 1;
+		int colStart = colDir > 0 ? meshSize.x - 1 : 0;
+		int colStep = colDir > 0 ? -1 : 1;
+		for (int row = rowStart; row >= 0 && row < meshSize.y; row += rowStep)
+		{
+			for (int column = colStart; column >= 0 && column < meshSize.x; column += colStep)
+			{
+				std::int16_t& distance = m_jumpTable[mapIndex1D(row, column, meshSize.x) * 8 + direction];
+				int nextRow = row + rowDir;
+				int nextColumn = column + colDir;
+				if (!isWalkable(nextRow, nextColumn))
+				{
+					distance = 0;
+					continue;
+				}
+				int nextIndex = mapIndex1D(nextRow, nextColumn, meshSize.x);
+				std::int16_t nextDistance = m_jumpTable[nextIndex * 8 + direction];
+				bool isJumpPoint = getForcedDirections(nextRow, nextColumn, rowDir, colDir) != 0;
+				if (isDiagonal)
+				{
+					isJumpPoint = isJumpPoint
+						|| m_jumpTable[nextIndex * 8 + DIRECTION_SLOT[encodeDirection(rowDir, 0)]] > 0
+						|| m_jumpTable[nextIndex * 8 + DIRECTION_SLOT[encodeDirection(0, colDir)]] > 0;
+				}
+				// Too long jumps are cut at next cell, additional jump point does not change the result
+				if (isJumpPoint || nextDistance == MAX_JUMP || nextDistance == -MAX_JUMP)
+				{
+					distance = 1;
+				}
+				else
+				{
+					distance = nextDistance > 0 ? nextDistance + 1 : nextDistance - 1;
+				}
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool JPSSolver::isWalkable(int row, int column) const
+{
+	sf::Vector2i meshSize = m_mesh->getMeshSize();
+	if (row < 0 || row >= meshSize.y || column < 0 || column >= meshSize.x)
+	{
+		return false;
+	}
+	return m_mesh->getCellTypes()[mapIndex1D(row, column, meshSize.x)] != SquareType::FULL;
+}
+
+////////////////////////////////////////////////////////////
+std::uint8_t JPSSolver::getForcedDirections(int row, int column, int rowDir, int colDir) const
+{
+	std::uint8_t directions = 0;
+	if (rowDir == 0)
+	{
+		// Horizontal move, cells above and below were reachable from previous cell
+		for (int side = -1; side <= 1; side += 2)
+		{
+			if (!isWalkable(row + side, column) && isWalkable(row + side, column + colDir))
+			{
+				directions |= directionBit(side, colDir);
+			}
+		}
+	}
+	else if (colDir == 0)
+	{
+		// Vertical move, cells on the left and right were reachable from previous cell
+		for (int side = -1; side <= 1; side += 2)
+		{
+			if (!isWalkable(row, column + side) && isWalkable(row + rowDir, column + side))
+			{
+				directions |= directionBit(rowDir, side);
+			}
+		}
+	}
+	else
+	{
+		if (!isWalkable(row - rowDir, column) && isWalkable(row - rowDir, column + colDir))
+		{
+			directions |= directionBit(-rowDir, colDir);
+		}
+		if (!isWalkable(row, column - colDir) && isWalkable(row + rowDir, column - colDir))
+		{
+			directions |= directionBit(rowDir, -colDir);
+		}
+	}
+	return directions;
+}
+
+////////////////////////////////////////////////////////////
+std::uint8_t JPSSolver::getSuccessorDirections(int row, int column, std::uint8_t parentDirection) const
+{
+	int rowDir = DIRECTION_ROW_OFFSET[parentDirection];
+	int colDir = DIRECTION_COL_OFFSET[parentDirection];
+	std::uint8_t directions = directionBit(rowDir, colDir);
+	if (rowDir != 0 && colDir != 0)
+	{
+		directions |= directionBit(rowDir, 0) | directionBit(0, colDir);
+	}
+	return directions | getForcedDirections(row, column, rowDir, colDir);
+}
+
+////////////////////////////////////////////////////////////
+int JPSSolver::jump(int row, int column, int rowDir, int colDir) const
+{
+	for (int steps = 1;; ++steps)
+	{
+		row += rowDir;
+		column += colDir;
+		if (!isWalkable(row, column))
+		{
+			return 0;
+		}
+		if ((row == m_finishRow && column == m_finishColumn) || getForcedDirections(row, column, rowDir, colDir))
+		{
+			return steps;
+		}
+		// Diagonal move stops where one of its straight components finds jump point
+		if (rowDir != 0 && colDir != 0 && (jump(row, column, rowDir, 0) || jump(row, column, 0, colDir)))
+		{
+			return steps;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+int JPSSolver::jumpPrecomputed(int row, int column, int direction) const
+{
+	int distance = m_jumpTable[mapIndex1D(row, column, m_mesh->getMeshSize().x) * 8 + direction];
+	int freeSteps = std::abs(distance);
+	int rowDir = JUMP_ROW[direction];
+	int colDir = JUMP_COL[direction];
+	int rowSteps = (m_finishRow - row) * rowDir;
+	int colSteps = (m_finishColumn - column) * colDir;
+	// Stop early if destination (or for diagonal move its row or column) is reached before jump point or wall
+	if (rowDir == 0)
+	{
+		if (m_finishRow == row && colSteps > 0 && colSteps <= freeSteps)
+		{
+			return colSteps;
+		}
+	}
+	else if (colDir == 0)
+	{
+		if (m_finishColumn == column && rowSteps > 0 && rowSteps <= freeSteps)
+		{
+			return rowSteps;
+		}
+	}
+	else if (rowSteps > 0 && colSteps > 0 && std::min(rowSteps, colSteps) <= freeSteps)
+	{
+		return std::min(rowSteps, colSteps);
+	}
+	return distance > 0 ? distance : 0;
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#pragma once
+#include "MeshSolver.h"
+#include "src/Utility/IndexedHeap.h"
+#include <cstdint>
+
+/// <summary>
+/// Way of finding jump points used by JPSSolver
+/// </summary>
+enum class JPSMode
+{
+	ONLINE,			//!< Scan grid for jump points during search (JPS)
+	PRECOMPUTED,	//!< Read jump distances from table rebuilt once per grid edit (JPS+)
+};
+
+/// <summary>
+/// A solver that uses Jump Point Search to find the shortest path from a starting point to a destination point on a Mesh.
+/// Symmetric paths are pruned and only jump points are queued, which is valid only if all walkable cells have the same weight.
+/// On grids with mixed weights solver falls back to plain A* expansion of all neighbours.
+/// </summary>
+class JPSSolver : public MeshSolver
+{
+public:
+	/// <summary>
+	/// Constructs an JPSSolver object that will operate on the given Mesh
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	/// <param name="mode">Way of finding jump points</param>
+	JPSSolver(Mesh* mesh, JPSMode mode = JPSMode::PRECOMPUTED);
+	/// <summary>
+	/// Resets the solver to its initial state
+	/// </summary>
+	void reset() override;
+	/// <summary>
+	/// Reset starting position of solver;
+	/// </summary>
+	void resetStartPosition() override;
+	/// <summary>
+	/// Returns a string representing the name of the solver.
+	/// </summary>
+	/// <returns></returns>
+	std::string getSolverName() override { return m_mode == JPSMode::PRECOMPUTED ? "JPS+ Solver" : "JPS Solver"; }
+private:
+	/// <summary>
+	/// Updates the solver by expanding one jump point.
+	/// This method is called repeatedly until the algorithm finds the destination point or determines that no path exists.
+	/// </summary>
+	virtual void updateSolver() override;
+	/// <summary>
+	/// Updates the path after the algorithm has finished.
+	/// This method is called once the destination point has been reached
+	/// </summary>
+	virtual void updatePath() override;
+	/// <summary>
+	/// Runs the JPS algorithm until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Expands one jump point.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepSolver();
+	/// <summary>
+	/// Move path reconstruction one cell towards start.
+	/// Cells between jump points are not visited, so path follows parent direction of last jump point until previous one is reached.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether path cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepJumpPath();
+	/// <summary>
+	/// Recheck weights and rebuild jump table if grid was edited since last search
+	/// </summary>
+	void updateGridData();
+	/// <summary>
+	/// Compute jump distances of all cells in all directions (JPS+)
+	/// </summary>
+	void buildJumpTable();
+	/// <summary>
+	/// Check if cell can be entered
+	/// </summary>
+	/// <param name="row">Row of cell</param>
+	/// <param name="column">Column of cell</param>
+	/// <returns>True if cell is inside mesh and is not a wall</returns>
+	bool isWalkable(int row, int column) const;
+	/// <summary>
+	/// Get neighbours of cell reached by move in given direction which can't be reached optimally without passing through it
+	/// </summary>
+	/// <param name="row">Row of cell</param>
+	/// <param name="column">Column of cell</param>
+	/// <param name="rowDir">Row offset of move [-1,1]</param>
+	/// <param name="colDir">Column offset of move [-1,1]</param>
+	/// <returns>Bit mask of directions leading to forced neighbours</returns>
+	std::uint8_t getForcedDirections(int row, int column, int rowDir, int colDir) const;
+	/// <summary>
+	/// Get directions worth scanning from expanded cell (natural and forced neighbours)
+	/// </summary>
+	/// <param name="row">Row of cell</param>
+	/// <param name="column">Column of cell</param>
+	/// <param name="parentDirection">Direction code of jump which reached the cell</param>
+	/// <returns>Bit mask of directions</returns>
+	std::uint8_t getSuccessorDirections(int row, int column, std::uint8_t parentDirection) const;
+	/// <summary>
+	/// Scan grid from cell in given direction until jump point, destination or wall is found (JPS)
+	/// </summary>
+	/// <param name="row">Row of cell</param>
+	/// <param name="column">Column of cell</param>
+	/// <param name="rowDir">Row offset of move [-1,1]</param>
+	/// <param name="colDir">Column offset of move [-1,1]</param>
+	/// <returns>Number of steps to jump point (0 if there is none)</returns>
+	int jump(int row, int column, int rowDir, int colDir) const;
+	/// <summary>
+	/// Read jump distance from table and stop early if destination lies on the way (JPS+)
+	/// </summary>
+	/// <param name="row">Row of cell</param>
+	/// <param name="column">Column of cell</param>
+	/// <param name="direction">Index of direction</param>
+	/// <returns>Number of steps to jump point (0 if there is none)</returns>
+	int jumpPrecomputed(int row, int column, int direction) const;
+private:
+	JPSMode m_mode;							//!< Way of finding jump points
+	IndexedHeap<int> m_cellContainer;		//!< The priority queue of jump points and their estimated path lengths
+	std::vector<std::int16_t> m_jumpTable;	//!< Jump distance of each cell in each of 8 directions (>0 jump point, <=0 number of free cells before wall)
+	std::uint32_t m_gridRevision{};			//!< Mesh revision for which grid data was computed
+	bool m_isGridDataValid{ false };		//!< Was grid data computed at least once
+	bool m_isUniform{ true };				//!< Do all walkable cells have the same weight
+	int m_stepWeight{ Mesh::MIN_CELL_WEIGHT };	//!< Weight of single step (lower bound if grid is not uniform)
+	int m_finishRow{};						//!< Row of destination cell in current search
+	int m_finishColumn{};					//!< Column of destination cell in current search
+	int m_pathDistance{};					//!< Distance of current path cell from start
+	std::uint8_t m_pathDirection{};			//!< Direction of move which reached current path segment
+};
\ No newline at end of file
@@ -0,0 +1,224 @@
+#include "LandmarkTable.h"
+#include <limits>
+
+////////////////////////////////////////////////////////////
+LandmarkTable::LandmarkTable(Mesh* mesh, int landmarkCount, int threadCount)
+	: m_mesh(mesh), m_threadPool(threadCount), m_landmarkCount{ std::max(1, landmarkCount) }
+{
+	m_searches.resize(m_threadPool.getThreadCount());
+}
+
+////////////////////////////////////////////////////////////
+void LandmarkTable::update()
+{
+	if (!m_isBuilt || isTerrainChanged())
+	{
+		build();
+		m_isBuilt = true;
+	}
+	m_revision = m_mesh->getRevision();
+}
+
+////////////////////////////////////////////////////////////
+void LandmarkTable::setTarget(int index)
+{
+	constexpr std::uint32_t UNREACHABLE = std::numeric_limits<std::uint32_t>::max();
+	std::size_t landmarkCount = m_landmarks.size();
+	m_targetDistances.resize(landmarkCount);
+	for (std::size_t i = 0; i < landmarkCount; ++i)
+	{
+		std::size_t position = static_cast<std::size_t>(index) * landmarkCount + i;
+		std::uint32_t distance = m_isWide ? m_wideDistances[position] : m_narrowDistances[position];
+		bool isReachable = m_isWide ? distance != UNREACHABLE : distance != std::numeric_limits<std::uint16_t>::max();
+		m_targetDistances[i] = isReachable ? static_cast<int>(distance) : -1;
+	}
+	m_targetWeight = m_terrain[index];
+}
+
+////////////////////////////////////////////////////////////
+void LandmarkTable::build()
+{
+	int cellCount = m_mesh->getCellCount();
+	m_terrain.resize(cellCount);
+	for (int i = 0; i < cellCount; ++i)
+	{
+		m_terrain[i] = getTerrain(i);
+	}
+	int maxHops = selectLandmarks();
+	// Shortest weighted path is never longer than the path with fewest steps
+	m_isWide = static_cast<long long>(maxHops) * Mesh::MAX_CELL_WEIGHT >= std::numeric_limits<std::uint16_t>::max();
+	std::size_t tableSize = static_cast<std::size_t>(cellCount) * m_landmarks.size();
+	if (m_isWide)
+	{
+		m_narrowDistances = {};
+		m_wideDistances.resize(tableSize);
+	}
+	else
+	{
+		m_wideDistances = {};
+		m_narrowDistances.resize(tableSize);
+	}
+	m_threadPool.parallelFor(static_cast<int>(m_landmarks.size()), 1, [this](int threadIndex, int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				computeDistances(i, m_searches[threadIndex]);
+			}
+		});
+	m_targetDistances.assign(m_landmarks.size(), -1);
+	m_buildCount++;
+}
+
+////////////////////////////////////////////////////////////
+bool LandmarkTable::isTerrainChanged()
+{
+	if (m_mesh->getRevision() == m_revision)
+	{
+		return false;
+	}
+	if (!m_mesh->getEditedCells(m_revision, m_editedCells))
+	{
+		// Edits are no longer recorded, compare whole mesh
+		m_editedCells.resize(m_terrain.size());
+		for (int i = 0; i < static_cast<int>(m_editedCells.size()); ++i)
+		{
+			m_editedCells[i] = i;
+		}
+	}
+	for (int index : m_editedCells)
+	{
+		if (getTerrain(index) != m_terrain[index])
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+int LandmarkTable::selectLandmarks()
+{
+	int cellCount = m_mesh->getCellCount();
+	m_landmarks.clear();
+	int firstOpen = 0;
+	while (firstOpen < cellCount && m_terrain[firstOpen] == 0)
+	{
+		firstOpen++;
+	}
+	if (firstOpen == cellCount)
+	{
+		return 0;
+	}
+	// Hop distance to closest landmark, cells of components without landmark count as infinitely far
+	std::vector<int> closestHops(cellCount);
+	for (int i = 0; i < cellCount; ++i)
+	{
+		closestHops[i] = m_terrain[i] == 0 ? -1 : std::numeric_limits<int>::max();
+	}
+	std::vector<int> hops(cellCount);
+	int landmark = countHops(firstOpen, hops).first;
+	int maxHops = 0;
+	while (static_cast<int>(m_landmarks.size()) < m_landmarkCount)
+	{
+		m_landmarks.push_back(landmark);
+		maxHops = std::max(maxHops, countHops(landmark, hops).second);
+		int farthestHops = 0;
+		for (int i = 0; i < cellCount; ++i)
+		{
+			if (hops[i] >= 0)
+			{
+				closestHops[i] = std::min(closestHops[i], hops[i]);
+			}
+			if (closestHops[i] > farthestHops)
+			{
+				farthestHops = closestHops[i];
+				landmark = i;
+			}
+		}
+		if (farthestHops == 0)
+		{
+			// Every open cell is a landmark
+			break;
+		}
+	}
+	return maxHops;
+}
+
+////////////////////////////////////////////////////////////
+std::pair<int, int> LandmarkTable::countHops(int source, std::vector<int>& hops)
+{
+	std::fill(hops.begin(), hops.end(), -1);
+	std::vector<int> frontier{ source };
+	std::vector<int> nextFrontier;
+	hops[source] = 0;
+	int level = 0;
+	int farthest = source;
+	while (!frontier.empty())
+	{
+		farthest = frontier.front();
+		level++;
+		for (int index : frontier)
+		{
+			for (auto [nextIndex, direction] : m_mesh->getNeighbours(index))
+			{
+				if (hops[nextIndex] < 0)
+				{
+					hops[nextIndex] = level;
+					nextFrontier.push_back(nextIndex);
+				}
+			}
+		}
+		frontier.swap(nextFrontier);
+		nextFrontier.clear();
+	}
+	return { farthest, hops[farthest] };
+}
+
+////////////////////////////////////////////////////////////
+void LandmarkTable::computeDistances(int slot, LandmarkSearch& search)
+{
+	constexpr std::uint32_t UNREACHABLE = std::numeric_limits<std::uint32_t>::max();
+	search.distances.assign(m_terrain.size(), UNREACHABLE);
+	search.queue.clear();
+	int landmark = m_landmarks[slot];
+	search.distances[landmark] = 0;
+	search.queue.push(landmark, 0);
+	while (!search.queue.empty())
+	{
+		auto [index, distance] = search.queue.pop();
+		// Skip entries left behind by shorter distance found later
+		if (static_cast<std::uint32_t>(distance) != search.distances[index])
+		{
+			continue;
+		}
+		for (auto [nextIndex, direction] : m_mesh->getNeighbours(index))
+		{
+			std::uint32_t nextDistance = distance + m_terrain[nextIndex];
+			if (nextDistance < search.distances[nextIndex])
+			{
+				search.distances[nextIndex] = nextDistance;
+				search.queue.push(nextIndex, static_cast<int>(nextDistance));
+			}
+		}
+	}
+	if (m_isWide)
+	{
+		storeDistances(m_wideDistances, slot, search.distances);
+	}
+	else
+	{
+		storeDistances(m_narrowDistances, slot, search.distances);
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<typename T>
+void LandmarkTable::storeDistances(std::vector<T>& table, int slot, const std::vector<std::uint32_t>& distances)
+{
+	constexpr std::uint32_t UNREACHABLE = std::numeric_limits<std::uint32_t>::max();
+	std::size_t landmarkCount = m_landmarks.size();
+	for (std::size_t i = 0; i < distances.size(); ++i)
+	{
+		table[i * landmarkCount + slot] = distances[i] == UNREACHABLE ? static_cast<T>(-1) : static_cast<T>(distances[i]);
+	}
+}
\ No newline at end of file
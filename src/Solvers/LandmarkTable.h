@@ -0,0 +1,156 @@
+#pragma once
+#include "src/Mesh/Mesh.h"
+#include "src/Utility/BucketQueue.h"
+#include "src/Utility/ThreadPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+/// <summary>
+/// Landmark distance tables for ALT (A*, Landmarks, Triangle inequality) heuristic.
+/// Landmarks are picked by farthest-point selection on hop distances, then distance from each landmark to every cell is computed in parallel.
+/// Distances treat every non-wall cell as passable, so they never exceed distances seen by solvers and bounds derived from them stay admissible and consistent.
+/// Tables are stored per cell (all landmarks of cell in one row) in 16 bits when longest distance fits, otherwise in 32 bits.
+/// </summary>
+class LandmarkTable
+{
+public:
+	/// <summary>
+	/// Create tables for mesh (nothing is computed until first update)
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	/// <param name="landmarkCount">Number of landmarks</param>
+	/// <param name="threadCount">Number of threads computing tables</param>
+	LandmarkTable(Mesh* mesh, int landmarkCount = DEFAULT_LANDMARK_COUNT, int threadCount = static_cast<int>(std::thread::hardware_concurrency()));
+	/// <summary>
+	/// Recompute tables if walls or weights changed since last update (moving start or destination keeps them)
+	/// </summary>
+	void update();
+	/// <summary>
+	/// Set cell to which distances are estimated
+	/// </summary>
+	/// <param name="index">Index of target cell</param>
+	void setTarget(int index);
+	/// <summary>
+	/// Get lower bound of distance from cell to target
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Largest triangle inequality bound over all landmarks</returns>
+	int estimate(int index) const
+	{
+		return m_isWide ? estimateRow(m_wideDistances, index) : estimateRow(m_narrowDistances, index);
+	}
+	/// <summary>
+	/// Get selected landmarks
+	/// </summary>
+	/// <returns>Indexes of landmark cells</returns>
+	const std::vector<int>& getLandmarks() const { return m_landmarks; }
+	/// <summary>
+	/// Check if tables needed 32 bit distances
+	/// </summary>
+	/// <returns>True if tables are stored in 32 bits</returns>
+	bool isWide() const { return m_isWide; }
+	/// <summary>
+	/// Get number of times tables were computed
+	/// </summary>
+	/// <returns>Number of builds</returns>
+	int getBuildCount() const { return m_buildCount; }
+	static constexpr int DEFAULT_LANDMARK_COUNT = 8;	//!< Default number of landmarks
+private:
+	/// <summary>
+	/// Buffers of one distance search
+	/// </summary>
+	struct LandmarkSearch
+	{
+		BucketQueue queue{ Mesh::MAX_CELL_WEIGHT };	//!< Cells waiting for expansion
+		std::vector<std::uint32_t> distances;		//!< Distance of each cell from landmark
+	};
+	/// <summary>
+	/// Select landmarks and compute their tables
+	/// </summary>
+	void build();
+	/// <summary>
+	/// Check if walls or weights differ from those tables were computed for
+	/// </summary>
+	/// <returns>True if tables are outdated</returns>
+	bool isTerrainChanged();
+	/// <summary>
+	/// Pick landmarks by farthest-point selection on hop distances
+	/// </summary>
+	/// <returns>Largest hop distance from any landmark to reachable cell</returns>
+	int selectLandmarks();
+	/// <summary>
+	/// Count steps from cell to every cell it can reach
+	/// </summary>
+	/// <param name="source">Index of source cell</param>
+	/// <param name="hops">Steps to each cell (-1 for unreachable)</param>
+	/// <returns>Index of farthest cell and its hop distance</returns>
+	std::pair<int, int> countHops(int source, std::vector<int>& hops);
+	/// <summary>
+	/// Compute distances from landmark and store them in its column of tables
+	/// </summary>
+	/// <param name="slot">Index of landmark</param>
+	/// <param name="search">Search buffers of calling thread</param>
+	void computeDistances(int slot, LandmarkSearch& search);
+	/// <summary>
+	/// Copy distances of landmark into its column of table
+	/// </summary>
+	/// <typeparam name="T">Type of stored distance</typeparam>
+	/// <param name="table">Table to fill</param>
+	/// <param name="slot">Index of landmark</param>
+	/// <param name="distances">Distances from landmark</param>
+	template<typename T>
+	void storeDistances(std::vector<T>& table, int slot, const std::vector<std::uint32_t>& distances);
+	/// <summary>
+	/// Get lower bound of distance from cell to target using given table
+	/// </summary>
+	/// <typeparam name="T">Type of stored distance</typeparam>
+	/// <param name="table">Table of distances</param>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Largest triangle inequality bound over all landmarks</returns>
+	template<typename T>
+	int estimateRow(const std::vector<T>& table, int index) const
+	{
+		constexpr T UNREACHABLE = static_cast<T>(-1);
+		const T* row = &table[static_cast<std::size_t>(index) * m_landmarks.size()];
+		int bound = 0;
+		for (std::size_t i = 0; i < m_landmarks.size(); ++i)
+		{
+			int targetDistance = m_targetDistances[i];
+			if (row[i] == UNREACHABLE || targetDistance < 0)
+			{
+				continue;
+			}
+			// Path cost counts weight of entered cell, so reversed distance swaps weights of both ends
+			int distance = static_cast<int>(row[i]);
+			bound = std::max(bound, targetDistance - distance);
+			bound = std::max(bound, distance - targetDistance - m_terrain[index] + m_targetWeight);
+		}
+		return bound;
+	}
+	/// <summary>
+	/// Get terrain value of cell
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Weight of cell or 0 for wall</returns>
+	std::uint8_t getTerrain(int index) const
+	{
+		return m_mesh->getCellTypes()[index] == SquareType::FULL ? 0 : m_mesh->getCellWeights()[index];
+	}
+private:
+	Mesh* m_mesh;									//!< Mesh on which distances are measured
+	ThreadPool m_threadPool;						//!< Threads computing tables
+	int m_landmarkCount;							//!< Requested number of landmarks
+	std::vector<int> m_landmarks;					//!< Selected landmark cells (fewer than requested if mesh has too few open cells)
+	std::vector<std::uint16_t> m_narrowDistances;	//!< Distances [cell * landmarks + landmark] when they fit 16 bits
+	std::vector<std::uint32_t> m_wideDistances;		//!< Distances [cell * landmarks + landmark] otherwise
+	bool m_isWide{ false };							//!< Which table is in use
+	std::vector<std::uint8_t> m_terrain;			//!< Weight of each cell (0 for wall) when tables were computed
+	std::vector<LandmarkSearch> m_searches;			//!< Search buffers of each thread
+	std::vector<int> m_editedCells;					//!< Cells edited since last update
+	std::uint32_t m_revision{};						//!< Mesh revision checked by last update
+	bool m_isBuilt{ false };						//!< Were tables computed at least once
+	int m_buildCount{};								//!< Number of times tables were computed
+	std::vector<int> m_targetDistances;				//!< Distance from each landmark to target (-1 if unreachable)
+	int m_targetWeight{};							//!< Weight of target cell
+};
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "src/Mesh/Mesh.h"
+#include <vector>
 
 /// <summary>
 /// Mapa index from 1D to 2D
@@ -24,6 +25,27 @@ inline int mapIndex1D(int row, int col, int width) {
 	return row * width + col;
 }
 
+/// <summary>
+/// Encode move to neighbour as direction code
+/// </summary>
+/// <param name="rowOffset">Row offset of move [-1,1]</param>
+/// <param name="colOffset">Column offset of move [-1,1]</param>
+/// <returns>Direction code</returns>
+inline std::uint8_t encodeDirection(int rowOffset, int colOffset) {
+	return static_cast<std::uint8_t>((rowOffset + 1) * 3 + colOffset + 1);
+}
+
+/// <summary>
+/// Get index of cell from which the move with given direction code was made
+/// </summary>
+/// <param name="index">Index of cell</param>
+/// <param name="direction">Direction code of move which reached the cell</param>
+/// <param name="width">Width of array</param>
+/// <returns>Index of parent cell</returns>
+inline int getParentIndex(int index, std::uint8_t direction, int width) {
+	return index - (DIRECTION_ROW_OFFSET[direction] * width + DIRECTION_COL_OFFSET[direction]);
+}
+
 /// <summary>
 /// Type of implemented solvers
 /// </summary>
@@ -33,12 +55,41 @@ enum class SolverType
 	BFS,
 	DJIKSTRA,
 	ASTAR,
+	DIAL,
+	JPS,
+	BIDIRECTIONAL_BFS,
+	BIDIRECTIONAL_DJIKSTRA,
+	BIDIRECTIONAL_ASTAR,
+	PARALLEL_BFS,
+	DELTA_STEPPING,
+	BIT_BFS,
+	HPA_STAR,
+	ASTAR_LANDMARKS,
+	DSTAR_LITE,
+	DISTANCE_FIELD,
+	ASTAR_OCTILE,
+	WEIGHTED_ASTAR,
+	IDA_STAR,
+	FRINGE_SEARCH,
+};
+
+/// <summary>
+/// Result of a headless (run-to-completion) solve
+/// </summary>
+struct SolveResult
+{
+	std::vector<int> path;			//!< Indexes of cells creating path (from destination side towards start)
+	bool isFound{ false };			//!< Flag indicating whether a path has been found
+	int processedSquares{};			//!< Number of cells processed by the algorithm
+	int pathLength{};				//!< Length of the path (in cells)
+	int pathWeight{};				//!< Total weight of the path
 };
 
 class MeshSolver
 {
 public:
 	MeshSolver(Mesh* mesh) : m_mesh{ mesh } {}
+	virtual ~MeshSolver() = default;
 	/// <summary>
 	/// Update visualiser ( update loop )
 	/// </summary>
@@ -47,7 +98,11 @@ public:
 		m_iterNumber++;
 		if (!m_isFinished)
 		{
-			if (!m_isFound)
+			if (m_iterNumber == 1 && isDisconnected())
+			{
+				m_isFinished = true;
+			}
+			else if (!m_isFound)
 			{
 				updateSolver();
 			}
@@ -58,6 +113,60 @@ public:
 		}
 	}
 	/// <summary>
+	/// Run whole search in a tight loop without any visualisation side effects
+	/// </summary>
+	/// <returns>True if path has been found</returns>
+	bool solve()
+	{
+		// Starting new search is O(1) thanks to epoch-stamped search state
+		m_mesh->resetMesh();
+		reset();
+		m_iterNumber++;
+		if (isDisconnected())
+		{
+			m_isFinished = true;
+			return false;
+		}
+		runSolver();
+		return m_isFound;
+	}
+	/// <summary>
+	/// Run whole search and path reconstruction without any visualisation side effects
+	/// </summary>
+	/// <returns>Found path and solver statistics</returns>
+	SolveResult solvePath()
+	{
+		if (solve())
+		{
+			runPath();
+		}
+		m_isFinished = true;
+		return SolveResult{ std::move(m_path), m_isFound, m_squareProcessed, m_pathLength, m_pathWeight };
+	}
+	/// <summary>
+	/// Get path and statistics found so far
+	/// </summary>
+	/// <returns>Copy of current result</returns>
+	SolveResult getResult() const { return SolveResult{ m_path, m_isFound, m_squareProcessed, m_pathLength, m_pathWeight }; }
+	/// <summary>
+	/// Show stored result of the same query as finished search, without searching (solver must be cleared)
+	/// </summary>
+	/// <param name="result">Result of earlier search</param>
+	void showResult(const SolveResult& result)
+	{
+		m_iterNumber++;
+		m_isFound = result.isFound;
+		m_isFinished = true;
+		m_squareProcessed = result.processedSquares;
+		m_pathLength = result.pathLength;
+		m_pathWeight = result.pathWeight;
+		m_path = result.path;
+		for (int index : m_path)
+		{
+			m_mesh->setCellColor(SquareType::PATH, index);
+		}
+	}
+	/// <summary>
 	/// Reset solver
 	/// </summary>
 	virtual void reset() = 0;
@@ -67,6 +176,11 @@ public:
 	/// <returns>True if solver is cleared</returns>
 	bool isClear() { return !m_iterNumber; }
 	/// <summary>
+	/// Has solver finished search and path reconstruction
+	/// </summary>
+	/// <returns>True if further updates do nothing</returns>
+	bool isFinished() const { return m_isFinished; }
+	/// <summary>
 	/// Get number of processed squares
 	/// </summary>
 	/// <returns>Processed squares number</returns>
@@ -82,6 +196,11 @@ public:
 	/// <returns>Path weight</returns>
 	int getPathWeight() const { return m_pathWeight; }
 	/// <summary>
+	/// Get mesh on which solver operates
+	/// </summary>
+	/// <returns>Pointer to mesh</returns>
+	Mesh* getMesh() const { return m_mesh; }
+	/// <summary>
 	/// Get solver name
 	/// </summary>
 	/// <returns>Solver name</returns>
@@ -97,6 +216,7 @@ public:
 		m_pathLength = 0;
 		m_pathWeight = 0;
 		m_iterNumber = 0;
+		m_path.clear();
 	}
 	/// <summary>
 	/// Reset starting position of solver
@@ -111,6 +231,55 @@ private:
 	/// Run another step of path visualisation
 	/// </summary>
 	virtual void updatePath() = 0;
+	/// <summary>
+	/// Run pathfinding until destination is found or there are no more cells to process (no visualisation)
+	/// </summary>
+	virtual void runSolver() = 0;
+	/// <summary>
+	/// Run path reconstruction until start is reached (no visualisation)
+	/// </summary>
+	virtual void runPath() = 0;
+protected:
+	/// <summary>
+	/// Check if start and destination lie in different regions, so search can be rejected before expanding any cell
+	/// </summary>
+	/// <returns>True if no path can exist</returns>
+	bool isDisconnected() { return !m_mesh->areConnected(m_mesh->getStartPosition(), m_mesh->getFinishPosition()); }
+	/// <summary>
+	/// Start path reconstruction from given cell
+	/// </summary>
+	/// <param name="index">Index of last cell before destination</param>
+	/// <param name="minStepCost">Lowest cost of one move used by search</param>
+	void beginPath(int index, int minStepCost = 1)
+	{
+		m_pathIndex = index;
+		// Every step costs at least minStepCost so distance bounds number of path cells
+		m_path.reserve(m_mesh->getSearchState().getDistance(index) / minStepCost + 1);
+	}
+	/// <summary>
+	/// Move path reconstruction one cell towards start using recorded parent directions
+	/// </summary>
+	/// <typeparam name="Visualise">Whether path cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepParentPath()
+	{
+		SearchState& searchState = m_mesh->getSearchState();
+		int index = m_pathIndex;
+		m_pathLength++;
+		m_pathWeight += m_mesh->getCellWeights()[index];
+		if (searchState.getDistance(index) == 0)
+		{
+			m_isFinished = true;
+			return;
+		}
+		searchState.setState(index, SquareType::PATH);
+		m_path.push_back(index);
+		if constexpr (Visualise)
+		{
+			m_mesh->setCellColor(SquareType::PATH, index);
+		}
+		m_pathIndex = getParentIndex(index, searchState.getParent(index), m_mesh->getMeshSize().x);
+	}
 protected:
 	Mesh* m_mesh;					//!< Pointer to mesh containing grid
 	bool m_isFound{ false };		//!< Flag indicating whether a path has been found
@@ -120,4 +289,6 @@ protected:
 	int m_pathLength{};				//!< Length of the path (in cells) from the starting point to the destination point
 	int m_pathWeight{};				//!< Total weight of the path (sum of weights of all cells in the path)
 	int m_iterNumber{};				//!< Number of iterations (i.e., iterations of the main loop) performed by the algorithm
+	std::vector<int> m_path;		//!< Cells creating path (filled during path reconstruction)
+	int m_pathIndex{};				//!< Current cell of path reconstruction
 };
\ No newline at end of file
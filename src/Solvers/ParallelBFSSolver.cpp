@@ -0,0 +1,259 @@
+#include "ParallelBFSSolver.h"
+#include "src/Utility/BitOperations.h"
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+ParallelBFSSolver::ParallelBFSSolver(Mesh* mesh, int threadCount)
+	: MeshSolver(mesh), m_threadPool(threadCount), m_localFrontiers(m_threadPool.getThreadCount())
+{
+	m_wordCount = (mesh->getCellCount() + 63) / 64;
+	m_visitedBits = std::make_unique<std::atomic<std::uint64_t>[]>(m_wordCount);
+	m_frontierBits = std::make_unique<std::atomic<std::uint64_t>[]>(m_wordCount);
+	reset();
+}
+
+////////////////////////////////////////////////////////////
+void ParallelBFSSolver::reset()
+{
+	resetStartPosition();
+	resetSolver();
+}
+
+void ParallelBFSSolver::resetStartPosition()
+{
+	m_frontier.assign(1, m_mesh->getStartPosition());
+	m_level = 0;
+	m_isBottomUp = false;
+	m_bottomUpLevels = 0;
+	m_isFinishReached = false;
+}
+
+////////////////////////////////////////////////////////////
+void ParallelBFSSolver::updateSolver()
+{
+	stepSolver<true>();
+}
+
+////////////////////////////////////////////////////////////
+void ParallelBFSSolver::updatePath()
+{
+	stepParentPath<true>();
+}
+
+////////////////////////////////////////////////////////////
+void ParallelBFSSolver::runSolver()
+{
+	while (!m_isFound && !m_isFinished)
+	{
+		stepSolver<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ParallelBFSSolver::runPath()
+{
+	while (!m_isFinished)
+	{
+		stepParentPath<false>();
+	}
+}
+
+////////////////////////////////////////////////////////////
+template<bool Visualise>
+void ParallelBFSSolver::stepSolver()
+{
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	SearchState& searchState = m_mesh->getSearchState();
+	int cellCount = m_mesh->getCellCount();
+	if (m_level == 0)
+	{
+		initialiseVisited();
+	}
+	int frontierSize = static_cast<int>(m_frontier.size());
+	if (!m_isBottomUp && frontierSize > m_unvisitedCount / ALPHA)
+	{
+		m_isBottomUp = true;
+	}
+	else if (m_isBottomUp && frontierSize < cellCount / BETA)
+	{
+		m_isBottomUp = false;
+	}
+	for (auto& localFrontier : m_localFrontiers)
+	{
+		localFrontier.clear();
+	}
+	if (m_isBottomUp)
+	{
+		expandBottomUp();
+		m_bottomUpLevels++;
+	}
+	else
+	{
+		expandTopDown();
+	}
+	// Mark current level as finished
+	m_threadPool.parallelFor(frontierSize, CHUNK_SIZE, [&](int, int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				if (cellTypes[m_frontier[i]] != SquareType::START)
+				{
+					searchState.setState(m_frontier[i], SquareType::PROCESSED);
+				}
+			}
+		});
+	m_squareProcessed += frontierSize;
+	if constexpr (Visualise)
+	{
+		for (int index : m_frontier)
+		{
+			if (cellTypes[index] != SquareType::START)
+			{
+				m_mesh->setCellColor(SquareType::PROCESSED, index);
+			}
+		}
+	}
+	// Gather next level from per-thread buffers
+	std::vector<int> offsets(m_localFrontiers.size() + 1);
+	for (size_t i = 0; i < m_localFrontiers.size(); ++i)
+	{
+		offsets[i + 1] = offsets[i] + static_cast<int>(m_localFrontiers[i].size());
+	}
+	m_frontier.resize(offsets.back());
+	m_threadPool.run([&](int threadIndex)
+		{
+			std::copy(m_localFrontiers[threadIndex].begin(), m_localFrontiers[threadIndex].end(), m_frontier.begin() + offsets[threadIndex]);
+		});
+	if constexpr (Visualise)
+	{
+		for (int index : m_frontier)
+		{
+			m_mesh->setCellColor(SquareType::QUEUED, index);
+		}
+	}
+	m_unvisitedCount -= offsets.back();
+	m_level++;
+	// Whole level is processed, so destination distance is final
+	if (m_isFinishReached)
+	{
+		int finishIndex = m_mesh->getFinishPosition();
+		m_isFound = true;
+		beginPath(getParentIndex(finishIndex, searchState.getParent(finishIndex), m_mesh->getMeshSize().x));
+		return;
+	}
+	if (m_frontier.empty())
+	{
+		m_isFinished = true;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ParallelBFSSolver::expandTopDown()
+{
+	m_threadPool.parallelFor(static_cast<int>(m_frontier.size()), CHUNK_SIZE, [&](int threadIndex, int begin, int end)
+		{
+			for (int k = begin; k < end; ++k)
+			{
+				// Walls are marked as visited, so bitmap alone decides if cell can be entered
+				for (auto [nextIndex, direction] : m_mesh->getNeighbours(m_frontier[k]))
+				{
+					if (tryVisit(nextIndex))
+					{
+						addToNextLevel(nextIndex, direction, threadIndex);
+					}
+				}
+			}
+		});
+}
+
+////////////////////////////////////////////////////////////
+void ParallelBFSSolver::expandBottomUp()
+{
+	// Build bitmap of current level
+	m_threadPool.parallelFor(m_wordCount, CHUNK_SIZE, [this](int, int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				m_frontierBits[i].store(0, std::memory_order_relaxed);
+			}
+		});
+	m_threadPool.parallelFor(static_cast<int>(m_frontier.size()), CHUNK_SIZE, [this](int, int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				m_frontierBits[m_frontier[i] >> 6].fetch_or(std::uint64_t(1) << (m_frontier[i] & 63), std::memory_order_relaxed);
+			}
+		});
+	// Each unvisited cell looks for any neighbour in current level, cells of a bitmap word are owned by thread processing it
+	m_threadPool.parallelFor(m_wordCount, CHUNK_SIZE / 8, [&](int threadIndex, int begin, int end)
+		{
+			for (int word = begin; word < end; ++word)
+			{
+				std::uint64_t unvisited = ~m_visitedBits[word].load(std::memory_order_relaxed);
+				while (unvisited)
+				{
+					int bitIndex = countTrailingZeros(unvisited);
+					unvisited &= unvisited - 1;
+					int index = word * 64 + bitIndex;
+					for (auto [neighbourIndex, direction] : m_mesh->getNeighbours(index))
+					{
+						if (m_frontierBits[neighbourIndex >> 6].load(std::memory_order_relaxed) & (std::uint64_t(1) << (neighbourIndex & 63)))
+						{
+							// Cell is entered by reversed move from its neighbour
+							m_visitedBits[word].fetch_or(std::uint64_t(1) << bitIndex, std::memory_order_relaxed);
+							addToNextLevel(index, 8 - direction, threadIndex);
+							break;
+						}
+					}
+				}
+			}
+		});
+}
+
+////////////////////////////////////////////////////////////
+void ParallelBFSSolver::initialiseVisited()
+{
+	const std::vector<SquareType>& cellTypes = m_mesh->getCellTypes();
+	int cellCount = m_mesh->getCellCount();
+	std::vector<int> localCounts(m_threadPool.getThreadCount());
+	m_threadPool.parallelFor(m_wordCount, CHUNK_SIZE / 8, [&](int threadIndex, int begin, int end)
+		{
+			for (int word = begin; word < end; ++word)
+			{
+				// Bits past last cell stay set so they are never treated as unvisited
+				std::uint64_t bits = ~std::uint64_t(0);
+				for (int bitIndex = 0; bitIndex < 64 && word * 64 + bitIndex < cellCount; ++bitIndex)
+				{
+					SquareType type = cellTypes[word * 64 + bitIndex];
+					if (type == SquareType::EMPTY || type == SquareType::FINISH)
+					{
+						bits &= ~(std::uint64_t(1) << bitIndex);
+						localCounts[threadIndex]++;
+					}
+				}
+				m_visitedBits[word].store(bits, std::memory_order_relaxed);
+			}
+		});
+	m_unvisitedCount = 0;
+	for (int count : localCounts)
+	{
+		m_unvisitedCount += count;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ParallelBFSSolver::addToNextLevel(int index, std::uint8_t direction, int threadIndex)
+{
+	SearchState& searchState = m_mesh->getSearchState();
+	searchState.visit(index, SquareType::QUEUED);
+	searchState.setDistance(index, m_level + 1);
+	searchState.setParent(index, direction);
+	if (m_mesh->getCellTypes()[index] == SquareType::FINISH)
+	{
+		m_isFinishReached.store(true, std::memory_order_relaxed);
+	}
+	else
+	{
+		m_localFrontiers[threadIndex].push_back(index);
+	}
+}
\ No newline at end of file
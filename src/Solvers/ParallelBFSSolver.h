@@ -0,0 +1,111 @@
+#pragma once
+#include "MeshSolver.h"
+#include "src/Utility/ThreadPool.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+/// <summary>
+/// A solver that uses level-synchronous breadth-first search spread over a thread pool to find the shortest path from a starting point to a destination point on a Mesh.
+/// Each step processes whole frontier level, top-down from frontier cells or bottom-up from unvisited cells once frontier gets dense.
+/// Distances of all cells up to destination level are the same as in BFSSolver.
+/// </summary>
+class ParallelBFSSolver : public MeshSolver
+{
+public:
+	/// <summary>
+	/// Constructs an ParallelBFSSolver object that will operate on the given Mesh
+	/// </summary>
+	/// <param name="mesh">A pointer to the Mesh object to operate on.</param>
+	/// <param name="threadCount">Number of threads processing each level</param>
+	ParallelBFSSolver(Mesh* mesh, int threadCount = static_cast<int>(std::thread::hardware_concurrency()));
+	/// <summary>
+	/// Resets the solver to its initial state
+	/// </summary>
+	void reset() override;
+	/// <summary>
+	/// Reset starting position of solver;
+	/// </summary>
+	void resetStartPosition() override;
+	/// <summary>
+	/// Returns a string representing the name of the solver.
+	/// </summary>
+	/// <returns></returns>
+	std::string getSolverName() override { return "Parallel BFS Solver"; }
+	/// <summary>
+	/// Returns number of levels processed bottom-up in last search.
+	/// </summary>
+	/// <returns>Number of bottom-up levels</returns>
+	int getBottomUpLevels() const { return m_bottomUpLevels; }
+private:
+	/// <summary>
+	/// Updates the solver by processing one frontier level.
+	/// This method is called repeatedly until the algorithm finds the destination point or determines that no path exists.
+	/// </summary>
+	virtual void updateSolver() override;
+	/// <summary>
+	/// Updates the path after the algorithm has finished.
+	/// This method is called once the destination point has been reached
+	/// </summary>
+	virtual void updatePath() override;
+	/// <summary>
+	/// Runs the BFS algorithm until the destination point is found or no path exists, without visualisation.
+	/// </summary>
+	virtual void runSolver() override;
+	/// <summary>
+	/// Reconstructs the whole path at once, without visualisation.
+	/// </summary>
+	virtual void runPath() override;
+	/// <summary>
+	/// Processes one frontier level.
+	/// </summary>
+	/// <typeparam name="Visualise">Whether processed cells should be coloured</typeparam>
+	template<bool Visualise>
+	void stepSolver();
+	/// <summary>
+	/// Expand every frontier cell into its unvisited neighbours
+	/// </summary>
+	void expandTopDown();
+	/// <summary>
+	/// Check every unvisited cell for neighbour in frontier
+	/// </summary>
+	void expandBottomUp();
+	/// <summary>
+	/// Fill visited bitmap with cells which can't be entered and count the rest
+	/// </summary>
+	void initialiseVisited();
+	/// <summary>
+	/// Mark cell as visited in this search
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>True if calling thread is first to visit cell</returns>
+	bool tryVisit(int index)
+	{
+		std::uint64_t bit = std::uint64_t(1) << (index & 63);
+		std::atomic<std::uint64_t>& word = m_visitedBits[index >> 6];
+		return !(word.load(std::memory_order_relaxed) & bit) && !(word.fetch_or(bit, std::memory_order_relaxed) & bit);
+	}
+	/// <summary>
+	/// Store distance and parent of newly visited cell and queue it to next level (called by owning thread only)
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <param name="direction">Direction code of move which reached the cell</param>
+	/// <param name="threadIndex">Index of calling thread</param>
+	void addToNextLevel(int index, std::uint8_t direction, int threadIndex);
+private:
+	static constexpr int ALPHA = 14;				//!< Switch to bottom-up when frontier is larger than unvisited cells / ALPHA
+	static constexpr int BETA = 24;					//!< Switch back to top-down when frontier is smaller than all cells / BETA
+	static constexpr int CHUNK_SIZE = 1024;			//!< Number of cells handed to thread at once
+	ThreadPool m_threadPool;						//!< Threads processing levels
+	std::vector<int> m_frontier;					//!< Cells of current level
+	std::vector<std::vector<int>> m_localFrontiers;	//!< Cells of next level found by each thread
+	std::unique_ptr<std::atomic<std::uint64_t>[]> m_visitedBits;	//!< Visited bitmap (cells which can't be entered are set too)
+	std::unique_ptr<std::atomic<std::uint64_t>[]> m_frontierBits;	//!< Bitmap of current level (bottom-up only)
+	int m_wordCount{};								//!< Number of words in each bitmap
+	int m_level{};									//!< Distance of current level from start
+	int m_unvisitedCount{};							//!< Number of walkable cells not visited yet
+	bool m_isBottomUp{ false };						//!< Direction of current level
+	int m_bottomUpLevels{};							//!< Number of levels processed bottom-up
+	std::atomic<bool> m_isFinishReached{ false };	//!< Destination was visited in current level
+};
\ No newline at end of file
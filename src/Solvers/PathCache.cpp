@@ -0,0 +1,134 @@
+#include "PathCache.h"
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+PathCache::PathCache(std::size_t capacity, std::size_t byteCapacity) : m_capacity{ std::max<std::size_t>(1, capacity) }, m_byteCapacity{ byteCapacity }
+{
+	m_index.reserve(m_capacity);
+}
+
+////////////////////////////////////////////////////////////
+SolveResult PathCache::solvePath(MeshSolver& solver)
+{
+	if (const SolveResult* result = find(solver))
+	{
+		return *result;
+	}
+	SolveResult result = solver.solvePath();
+	insert(solver, result);
+	return result;
+}
+
+////////////////////////////////////////////////////////////
+const SolveResult* PathCache::find(MeshSolver& solver)
+{
+	auto it = m_index.find(makeKey(solver));
+	// Equal hash of different content is treated as miss
+	if (it == m_index.end() || !hasContent(*it->second->content, *solver.getMesh()))
+	{
+		m_misses++;
+		return nullptr;
+	}
+	m_hits++;
+	m_entries.splice(m_entries.begin(), m_entries, it->second);
+	return &it->second->result;
+}
+
+////////////////////////////////////////////////////////////
+void PathCache::insert(MeshSolver& solver, SolveResult result)
+{
+	Key key = makeKey(solver);
+	std::shared_ptr<const Content> content = shareContent(*solver.getMesh(), key.contentHash);
+	auto it = m_index.find(key);
+	if (it != m_index.end())
+	{
+		erase(it->second);
+	}
+	m_bytes += result.path.size() * sizeof(int);
+	m_entries.push_front(Entry{ key, std::move(result), std::move(content) });
+	m_index.emplace(key, m_entries.begin());
+	while (!m_entries.empty() && (m_entries.size() > m_capacity || m_bytes > m_byteCapacity))
+	{
+		erase(std::prev(m_entries.end()));
+	}
+}
+
+////////////////////////////////////////////////////////////
+void PathCache::clear()
+{
+	m_entries.clear();
+	m_index.clear();
+	m_contents.clear();
+	m_bytes = 0;
+}
+
+////////////////////////////////////////////////////////////
+PathCache::Key PathCache::makeKey(MeshSolver& solver)
+{
+	Mesh* mesh = solver.getMesh();
+	return Key{ mesh->getContentHash(), solver.getSolverName(), mesh->getStartPosition(), mesh->getFinishPosition() };
+}
+
+////////////////////////////////////////////////////////////
+bool PathCache::hasContent(const Content& content, const Mesh& mesh)
+{
+	return content.meshSize == mesh.getMeshSize() && content.cellTypes == mesh.getCellTypes() && content.cellWeights == mesh.getCellWeights();
+}
+
+////////////////////////////////////////////////////////////
+std::size_t PathCache::getContentBytes(const Content& content)
+{
+	return content.cellTypes.size() * sizeof(SquareType) + content.cellWeights.size() * sizeof(std::uint8_t);
+}
+
+////////////////////////////////////////////////////////////
+std::shared_ptr<const PathCache::Content> PathCache::shareContent(const Mesh& mesh, std::uint64_t contentHash)
+{
+	// Solvers of all panels usually answer queries on the same copied mesh
+	auto [first, last] = m_contents.equal_range(contentHash);
+	for (auto it = first; it != last; ++it)
+	{
+		if (hasContent(*it->second, mesh))
+		{
+			return it->second;
+		}
+	}
+	auto content = std::make_shared<const Content>(Content{ mesh.getMeshSize(), mesh.getCellTypes(), mesh.getCellWeights() });
+	m_bytes += getContentBytes(*content);
+	m_contents.emplace(contentHash, content);
+	return content;
+}
+
+////////////////////////////////////////////////////////////
+void PathCache::erase(std::list<Entry>::iterator entry)
+{
+	std::uint64_t contentHash = entry->key.contentHash;
+	std::shared_ptr<const Content> content = std::move(entry->content);
+	m_bytes -= entry->result.path.size() * sizeof(int);
+	m_index.erase(entry->key);
+	m_entries.erase(entry);
+	// Content map and this function are the last holders of content
+	if (content.use_count() == 2)
+	{
+		auto [first, last] = m_contents.equal_range(contentHash);
+		for (auto it = first; it != last; ++it)
+		{
+			if (it->second == content)
+			{
+				m_bytes -= getContentBytes(*content);
+				m_contents.erase(it);
+				break;
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+std::size_t PathCache::KeyHash::operator()(const Key& key) const
+{
+	std::size_t hash = std::hash<std::string>()(key.solverName);
+	hash ^= static_cast<std::size_t>(key.contentHash) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+	hash ^= static_cast<std::size_t>(key.start) * 0x85EBCA6B + (hash << 6) + (hash >> 2);
+	hash ^= static_cast<std::size_t>(key.finish) * 0xC2B2AE35 + (hash << 6) + (hash >> 2);
+	return hash;
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+#include "MeshSolver.h"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/// <summary>
+/// Least recently used cache of solved paths.
+/// Entry is keyed by content hash of mesh, solver name, start and destination, so re-solving the same query on unchanged
+/// (or identically re-copied) mesh returns stored result without searching.
+/// Entry also keeps cell types and weights it was solved on (one copy per distinct content) and hit compares them,
+/// so two meshes with colliding hash never share result.
+/// Cache is bounded both by number of results and by bytes of stored contents and paths.
+/// </summary>
+class PathCache
+{
+public:
+	/// <summary>
+	/// Identity of path query
+	/// </summary>
+	struct Key
+	{
+		std::uint64_t contentHash{};	//!< Content hash of mesh
+		std::string solverName;			//!< Name of solver which answered query
+		int start{};					//!< Index of start cell
+		int finish{};					//!< Index of destination cell
+		bool operator==(const Key& key) const
+		{
+			return contentHash == key.contentHash && start == key.start && finish == key.finish && solverName == key.solverName;
+		}
+	};
+	/// <summary>
+	/// Create cache
+	/// </summary>
+	/// <param name="capacity">Maximum number of stored paths</param>
+	/// <param name="byteCapacity">Maximum number of bytes held by stored contents and paths</param>
+	explicit PathCache(std::size_t capacity = DEFAULT_CAPACITY, std::size_t byteCapacity = DEFAULT_BYTE_CAPACITY);
+	/// <summary>
+	/// Solve path on solver's mesh or return stored result of the same query
+	/// </summary>
+	/// <param name="solver">Solver answering query</param>
+	/// <returns>Found path and solver statistics (statistics of original search on hit)</returns>
+	SolveResult solvePath(MeshSolver& solver);
+	/// <summary>
+	/// Find stored result of solver's query on its current mesh and mark it as most recently used
+	/// </summary>
+	/// <param name="solver">Solver answering query</param>
+	/// <returns>Stored result or nullptr</returns>
+	const SolveResult* find(MeshSolver& solver);
+	/// <summary>
+	/// Store result of solver's query on its current mesh, evicting least recently used ones while cache is over its bounds
+	/// (result which alone exceeds byte capacity is not kept)
+	/// </summary>
+	/// <param name="solver">Solver which answered query</param>
+	/// <param name="result">Result of query</param>
+	void insert(MeshSolver& solver, SolveResult result);
+	/// <summary>
+	/// Remove all stored results (counters are kept)
+	/// </summary>
+	void clear();
+	/// <summary>
+	/// Get number of queries answered from cache
+	/// </summary>
+	/// <returns>Number of hits</returns>
+	int getHits() const { return m_hits; }
+	/// <summary>
+	/// Get number of queries which had to be solved
+	/// </summary>
+	/// <returns>Number of misses</returns>
+	int getMisses() const { return m_misses; }
+	/// <summary>
+	/// Get number of stored results
+	/// </summary>
+	/// <returns>Number of entries</returns>
+	std::size_t getSize() const { return m_entries.size(); }
+	/// <summary>
+	/// Get maximum number of stored results
+	/// </summary>
+	/// <returns>Capacity</returns>
+	std::size_t getCapacity() const { return m_capacity; }
+	/// <summary>
+	/// Get number of bytes held by stored contents and paths
+	/// </summary>
+	/// <returns>Used bytes</returns>
+	std::size_t getBytes() const { return m_bytes; }
+	/// <summary>
+	/// Get maximum number of bytes held by stored contents and paths
+	/// </summary>
+	/// <returns>Byte capacity</returns>
+	std::size_t getByteCapacity() const { return m_byteCapacity; }
+private:
+	/// <summary>
+	/// Hash of query key
+	/// </summary>
+	struct KeyHash
+	{
+		std::size_t operator()(const Key& key) const;
+	};
+	/// <summary>
+	/// Mesh content query was solved on
+	/// </summary>
+	struct Content
+	{
+		sf::Vector2i meshSize;					//!< Size of mesh
+		std::vector<SquareType> cellTypes;		//!< Types of cells
+		std::vector<std::uint8_t> cellWeights;	//!< Weights of cells
+	};
+	/// <summary>
+	/// Stored result
+	/// </summary>
+	struct Entry
+	{
+		Key key;								//!< Query
+		SolveResult result;						//!< Result of query
+		std::shared_ptr<const Content> content;	//!< Mesh content result is valid for
+	};
+	/// <summary>
+	/// Build key of solver's query on its current mesh
+	/// </summary>
+	/// <param name="solver">Solver answering query</param>
+	/// <returns>Query key</returns>
+	static Key makeKey(MeshSolver& solver);
+	/// <summary>
+	/// Check if mesh holds given content
+	/// </summary>
+	/// <param name="content">Stored content</param>
+	/// <param name="mesh">Mesh to compare</param>
+	/// <returns>True if size, types and weights are equal</returns>
+	static bool hasContent(const Content& content, const Mesh& mesh);
+	/// <summary>
+	/// Get number of bytes held by content
+	/// </summary>
+	/// <param name="content">Stored content</param>
+	/// <returns>Bytes of cell types and weights</returns>
+	static std::size_t getContentBytes(const Content& content);
+	/// <summary>
+	/// Get stored copy of mesh content, storing new copy if no entry holds equal content
+	/// </summary>
+	/// <param name="mesh">Mesh to copy</param>
+	/// <param name="contentHash">Content hash of mesh</param>
+	/// <returns>Content of mesh</returns>
+	std::shared_ptr<const Content> shareContent(const Mesh& mesh, std::uint64_t contentHash);
+	/// <summary>
+	/// Remove stored result, and its content if no other entry uses it
+	/// </summary>
+	/// <param name="entry">Position of entry</param>
+	void erase(std::list<Entry>::iterator entry);
+	static constexpr std::size_t DEFAULT_CAPACITY = 64;						//!< Default maximum number of stored paths
+	static constexpr std::size_t DEFAULT_BYTE_CAPACITY = 32 * 1024 * 1024;	//!< Default maximum number of bytes held by stored contents and paths
+	std::size_t m_capacity;				//!< Maximum number of stored paths
+	std::size_t m_byteCapacity;			//!< Maximum number of bytes held by stored contents and paths
+	std::size_t m_bytes{};				//!< Number of bytes held by stored contents and paths
+	std::list<Entry> m_entries;			//!< Stored results, most recently used first
+	std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;	//!< Position of each stored query
+	std::unordered_multimap<std::uint64_t, std::shared_ptr<const Content>> m_contents;	//!< Stored contents by content hash
+	int m_hits{};						//!< Number of queries answered from cache
+	int m_misses{};						//!< Number of queries which had to be solved
+};
\ No newline at end of file
@@ -0,0 +1,174 @@
+#pragma once
+#include "src/Mesh/Mesh.h"
+#include <string>
+#include <type_traits>
+
+/// <summary>
+/// Moves allowed between cells (runtime choice of connectivity policy)
+/// </summary>
+enum class MoveSet
+{
+	FOUR,						//!< Straight moves only
+	EIGHT,						//!< Straight and diagonal moves
+	EIGHT_NO_CORNER_CUTTING,	//!< Diagonal moves only when both cells they pass by are not walls
+};
+
+/// <summary>
+/// Cost of moves between cells (runtime choice of cost policy)
+/// </summary>
+enum class MoveCost
+{
+	UNIT,			//!< Every move costs 1
+	CELL_WEIGHT,	//!< Move costs weight of entered cell
+	OCTILE,			//!< Move costs weight of entered cell, diagonal moves are longer by fixed-point sqrt(2)
+};
+
+/// <summary>
+/// Neighbour slots of straight moves (up, left, right, down)
+/// </summary>
+inline constexpr unsigned STRAIGHT_SLOTS = 0b01011010;
+
+/// <summary>
+/// Check if direction code encodes diagonal move
+/// </summary>
+/// <param name="direction">Direction code</param>
+/// <returns>True for diagonal move</returns>
+inline constexpr bool isDiagonalDirection(std::uint8_t direction)
+{
+	return DIRECTION_ROW_OFFSET[direction] != 0 && DIRECTION_COL_OFFSET[direction] != 0;
+}
+
+/// <summary>
+/// Connectivity policy with straight moves only
+/// </summary>
+struct FourConnectivity
+{
+	static constexpr const char* NAME = "4-connected";
+	static constexpr unsigned filterMask(unsigned mask) { return mask & STRAIGHT_SLOTS; }
+};
+
+/// <summary>
+/// Connectivity policy with straight and diagonal moves (default of all solvers)
+/// </summary>
+struct EightConnectivity
+{
+	static constexpr const char* NAME = "8-connected";
+	static constexpr unsigned filterMask(unsigned mask) { return mask; }
+};
+
+/// <summary>
+/// Connectivity policy with diagonal moves which do not squeeze between walls or around their corners
+/// </summary>
+struct NoCornerCuttingConnectivity
+{
+	static constexpr const char* NAME = "no corner cutting";
+	static constexpr unsigned filterMask(unsigned mask)
+	{
+		unsigned up = mask >> 1 & 1;
+		unsigned left = mask >> 3 & 1;
+		unsigned right = mask >> 4 & 1;
+		unsigned down = mask >> 6 & 1;
+		unsigned corners = (up & left) | (up & right) << 2 | (down & left) << 5 | (down & right) << 7;
+		return mask & (STRAIGHT_SLOTS | corners);
+	}
+};
+
+/// <summary>
+/// Cost policy counting moves
+/// </summary>
+struct UnitCost
+{
+	static constexpr const char* NAME = "unit cost";
+	static constexpr int getStraightCost(std::uint8_t) { return 1; }
+	static constexpr int getMoveCost(std::uint8_t, std::uint8_t) { return 1; }
+};
+
+/// <summary>
+/// Cost policy summing weights of entered cells (default of all solvers)
+/// </summary>
+struct WeightCost
+{
+	static constexpr const char* NAME = "cell weight";
+	static constexpr int getStraightCost(std::uint8_t weight) { return weight; }
+	static constexpr int getMoveCost(std::uint8_t weight, std::uint8_t) { return weight; }
+};
+
+/// <summary>
+/// Cost policy summing weights of entered cells scaled by length of move.
+/// 41/29 is the closest ratio to sqrt(2) (0.03% off) which keeps distances of 2048x2048 mesh of heaviest cells inside int.
+/// </summary>
+struct OctileCost
+{
+	static constexpr const char* NAME = "octile";
+	static constexpr int STRAIGHT_COST = 29;	//!< Length of straight move
+	static constexpr int DIAGONAL_COST = 41;	//!< Length of diagonal move
+	static constexpr int getStraightCost(std::uint8_t weight) { return weight * STRAIGHT_COST; }
+	static constexpr int getMoveCost(std::uint8_t weight, std::uint8_t direction)
+	{
+		return weight * (isDiagonalDirection(direction) ? DIAGONAL_COST : STRAIGHT_COST);
+	}
+};
+
+/// <summary>
+/// Check if connectivity policy allows diagonal moves
+/// </summary>
+/// <typeparam name="Connectivity">Connectivity policy</typeparam>
+/// <returns>True if some diagonal slot can pass the filter</returns>
+template<typename Connectivity>
+constexpr bool hasDiagonalMoves()
+{
+	return (Connectivity::filterMask(0xFF) & ~STRAIGHT_SLOTS) != 0;
+}
+
+/// <summary>
+/// Heuristic policy estimating remaining cost as Manhattan distance (admissible only without diagonal moves)
+/// </summary>
+struct ManhattanHeuristic
+{
+	static constexpr const char* NAME = "Manhattan";
+	static constexpr int estimate(int rows, int columns, int straightCost, int) { return (rows + columns) * straightCost; }
+};
+
+/// <summary>
+/// Heuristic policy estimating remaining cost as Chebyshev distance (admissible with every policy, diagonal move is never cheaper than straight one)
+/// </summary>
+struct ChebyshevHeuristic
+{
+	static constexpr const char* NAME = "Chebyshev";
+	static constexpr int estimate(int rows, int columns, int straightCost, int) { return std::max(rows, columns) * straightCost; }
+};
+
+/// <summary>
+/// Heuristic policy estimating remaining cost as octile distance, exact on open mesh of lowest weights (admissible with every policy)
+/// </summary>
+struct OctileHeuristic
+{
+	static constexpr const char* NAME = "Octile";
+	static constexpr int estimate(int rows, int columns, int straightCost, int diagonalCost)
+	{
+		int diagonals = std::min(rows, columns);
+		return (std::max(rows, columns) - diagonals) * straightCost + diagonals * diagonalCost;
+	}
+};
+
+/// <summary>
+/// Append policies which differ from defaults to solver name, so every instantiation has its own name
+/// </summary>
+/// <typeparam name="Connectivity">Connectivity policy</typeparam>
+/// <typeparam name="Cost">Cost policy (void for solvers which ignore cost)</typeparam>
+/// <param name="solverName">Name of solver</param>
+/// <returns>Name of instantiation</returns>
+template<typename Connectivity, typename Cost = void>
+std::string getPolicyName(const std::string& solverName)
+{
+	std::string policies;
+	if constexpr (!std::is_same_v<Connectivity, EightConnectivity>)
+	{
+		policies = Connectivity::NAME;
+	}
+	if constexpr (!std::is_void_v<Cost> && !std::is_same_v<Cost, WeightCost>)
+	{
+		policies += (policies.empty() ? "" : ", ") + std::string(Cost::NAME);
+	}
+	return policies.empty() ? solverName : solverName + " (" + policies + ")";
+}
\ No newline at end of file
@@ -0,0 +1,304 @@
+#pragma once
+#include "BitOperations.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/// <summary>
+/// Grid of bits packed into 64-bit words row by row (bit c of word k holds column 64 * k + c).
+/// Words are grouped into blocks of 256 cells, every row is preceded by a zero guard block and grid is surrounded by zero guard rows,
+/// so neighbour words of any block can be read without bounds checks.
+/// Summary keeps one bit per block which may hold set bits, so sparse grids are processed block by block.
+/// </summary>
+class BitGrid
+{
+public:
+	static constexpr int BLOCK_WORDS = 4;	//!< Number of words in block (one AVX2 register)
+	/// <summary>
+	/// Create empty grid
+	/// </summary>
+	/// <param name="width">Number of columns</param>
+	/// <param name="height">Number of rows</param>
+	BitGrid(int width = 0, int height = 0) { resize(width, height); }
+	/// <summary>
+	/// Change size of grid (clears all bits)
+	/// </summary>
+	/// <param name="width">Number of columns</param>
+	/// <param name="height">Number of rows</param>
+	void resize(int width, int height)
+	{
+		m_width = width;
+		m_height = height;
+		m_rowBlocks = (width + BLOCK_WORDS * 64 - 1) / (BLOCK_WORDS * 64);
+		m_stride = (m_rowBlocks + 1) * BLOCK_WORDS;
+		m_words.assign(static_cast<size_t>(height + 2) * m_stride + BLOCK_WORDS, 0);
+		m_summaryWords = (m_rowBlocks + 63) / 64;
+		m_summaryStride = m_summaryWords + 1;
+		m_summary.assign(static_cast<size_t>(height + 2) * m_summaryStride + 1, 0);
+	}
+	/// <summary>
+	/// Clear all bits
+	/// </summary>
+	void clear()
+	{
+		std::fill(m_words.begin(), m_words.end(), 0);
+		std::fill(m_summary.begin(), m_summary.end(), 0);
+	}
+	/// <summary>
+	/// Fill whole grid from per-cell predicate
+	/// </summary>
+	/// <param name="predicate">Function receiving index of cell and returning its bit</param>
+	template<typename Predicate>
+	void assign(Predicate&& predicate)
+	{
+		clear();
+		for (int row = 0; row < m_height; ++row)
+		{
+			std::uint64_t* words = &m_words[getRowOffset(row + 1)];
+			for (int k = 0; k * 64 < m_width; ++k)
+			{
+				std::uint64_t word = 0;
+				for (int bit = 0; bit < 64 && k * 64 + bit < m_width; ++bit)
+				{
+					word |= std::uint64_t(predicate(row * m_width + k * 64 + bit)) << bit;
+				}
+				words[k] = word;
+				if (word)
+				{
+					setActive(row + 1, k / BLOCK_WORDS);
+				}
+			}
+		}
+	}
+	/// <summary>
+	/// Set bit of cell
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	void set(int index)
+	{
+		m_words[getWordIndex(index)] |= getBit(index);
+		setActive(index / m_width + 1, (index % m_width) / (BLOCK_WORDS * 64));
+	}
+	/// <summary>
+	/// Set all bits which are set in other grid of the same size (only its active blocks are read)
+	/// </summary>
+	/// <param name="other">Grid to merge</param>
+	void unite(const BitGrid& other)
+	{
+		other.forEachBlock([&](int row, int block)
+			{
+				size_t offset = getRowOffset(row) + block * BLOCK_WORDS;
+				for (int k = 0; k < BLOCK_WORDS; ++k)
+				{
+					m_words[offset + k] |= other.m_words[offset + k];
+				}
+				setActive(row, block);
+			});
+	}
+	/// <summary>
+	/// Check bit of cell
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>True if bit is set</returns>
+	bool test(int index) const { return m_words[getWordIndex(index)] & getBit(index); }
+	/// <summary>
+	/// Get number of set bits
+	/// </summary>
+	/// <returns>Number of set bits</returns>
+	int count() const
+	{
+		int result = 0;
+		forEachBlock([&](int row, int block)
+			{
+				const std::uint64_t* words = &m_words[getRowOffset(row) + block * BLOCK_WORDS];
+				for (int k = 0; k < BLOCK_WORDS; ++k)
+				{
+					result += popCount(words[k]);
+				}
+			});
+		return result;
+	}
+	/// <summary>
+	/// Call function for every set bit, in index order
+	/// </summary>
+	/// <param name="function">Function receiving index of cell</param>
+	template<typename Function>
+	void forEach(Function&& function) const
+	{
+		forEachBlock([&](int row, int block)
+			{
+				const std::uint64_t* words = &m_words[getRowOffset(row) + block * BLOCK_WORDS];
+				for (int k = 0; k < BLOCK_WORDS; ++k)
+				{
+					std::uint64_t word = words[k];
+					while (word)
+					{
+						function((row - 1) * m_width + (block * BLOCK_WORDS + k) * 64 + countTrailingZeros(word));
+						word &= word - 1;
+					}
+				}
+			});
+	}
+	/// <summary>
+	/// Grow frontier by one 8-connected step: next = dilate(frontier) AND free AND NOT visited, visited |= next.
+	/// Only blocks next to active blocks of frontier are computed.
+	/// </summary>
+	/// <param name="frontier">Cells of current wave</param>
+	/// <param name="free">Cells which can be entered</param>
+	/// <param name="visited">Cells reached so far (updated)</param>
+	/// <param name="next">Cells of next wave (overwritten)</param>
+	/// <returns>True if next wave is not empty</returns>
+	static bool expand(const BitGrid& frontier, const BitGrid& free, BitGrid& visited, BitGrid& next)
+	{
+		const std::uint64_t* f = frontier.m_words.data();
+		const std::uint64_t* allowed = free.m_words.data();
+		std::uint64_t* v = visited.m_words.data();
+		std::uint64_t* n = next.m_words.data();
+		const int stride = frontier.m_stride;
+		const int summaryStride = frontier.m_summaryStride;
+		bool isExpanded = false;
+		for (int row = 1; row <= frontier.m_height; ++row)
+		{
+			// Next grid still holds wave before current one, clear its blocks first
+			next.forEachRowBlock(row, [&](int block)
+				{
+					std::fill_n(n + next.getRowOffset(row) + block * BLOCK_WORDS, BLOCK_WORDS, 0);
+				});
+			std::fill_n(&next.m_summary[static_cast<size_t>(row) * summaryStride + 1], frontier.m_summaryWords, 0);
+			for (int s = 0; s < frontier.m_summaryWords; ++s)
+			{
+				// Block may receive cells only if it or its neighbour block is active in one of three frontier rows
+				std::uint64_t candidates = dilate(&frontier.m_summary[static_cast<size_t>(row) * summaryStride + 1 + s], summaryStride);
+				if (s == frontier.m_summaryWords - 1 && frontier.m_rowBlocks % 64)
+				{
+					candidates &= (std::uint64_t(1) << (frontier.m_rowBlocks % 64)) - 1;
+				}
+				while (candidates)
+				{
+					int block = s * 64 + countTrailingZeros(candidates);
+					candidates &= candidates - 1;
+					int i = row * stride + BLOCK_WORDS + block * BLOCK_WORDS;
+#ifdef __AVX2__
+					// Same formula as scalar version on whole block (256 cells), neighbour words come from unaligned loads
+					__m256i centre = _mm256_or_si256(_mm256_or_si256(load(f + i - stride), load(f + i)), load(f + i + stride));
+					__m256i left = _mm256_or_si256(_mm256_or_si256(load(f + i - 1 - stride), load(f + i - 1)), load(f + i - 1 + stride));
+					__m256i right = _mm256_or_si256(_mm256_or_si256(load(f + i + 1 - stride), load(f + i + 1)), load(f + i + 1 + stride));
+					__m256i dilated = _mm256_or_si256(centre, _mm256_or_si256(
+						_mm256_or_si256(_mm256_slli_epi64(centre, 1), _mm256_srli_epi64(left, 63)),
+						_mm256_or_si256(_mm256_srli_epi64(centre, 1), _mm256_slli_epi64(right, 63))));
+					__m256i visitedWords = load(v + i);
+					__m256i result = _mm256_andnot_si256(visitedWords, _mm256_and_si256(dilated, load(allowed + i)));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(n + i), result);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(v + i), _mm256_or_si256(visitedWords, result));
+					bool isActive = !_mm256_testz_si256(result, result);
+#else
+					std::uint64_t any = 0;
+					for (int k = i; k < i + BLOCK_WORDS; ++k)
+					{
+						std::uint64_t result = dilate(f + k, stride) & allowed[k] & ~v[k];
+						n[k] = result;
+						v[k] |= result;
+						any |= result;
+					}
+					bool isActive = any != 0;
+#endif
+					if (isActive)
+					{
+						next.setActive(row, block);
+						isExpanded = true;
+					}
+				}
+			}
+		}
+		return isExpanded;
+	}
+private:
+	/// <summary>
+	/// 8-connected dilation of one word: bits of word and its 8 neighbours, moved by one column within word and carried over from neighbour words
+	/// </summary>
+	/// <param name="word">Address of word</param>
+	/// <param name="stride">Distance between rows in words</param>
+	/// <returns>Dilated word</returns>
+	static std::uint64_t dilate(const std::uint64_t* word, int stride)
+	{
+		std::uint64_t centre = word[-stride] | word[0] | word[stride];
+		std::uint64_t left = word[-1 - stride] | word[-1] | word[-1 + stride];
+		std::uint64_t right = word[1 - stride] | word[1] | word[1 + stride];
+		return centre | (centre << 1) | (left >> 63) | (centre >> 1) | (right << 63);
+	}
+	/// <summary>
+	/// Call function for every active block of grid
+	/// </summary>
+	/// <param name="function">Function receiving row (counted from 1) and block</param>
+	template<typename Function>
+	void forEachBlock(Function&& function) const
+	{
+		for (int row = 1; row <= m_height; ++row)
+		{
+			forEachRowBlock(row, [&](int block) { function(row, block); });
+		}
+	}
+	/// <summary>
+	/// Call function for every active block of row
+	/// </summary>
+	/// <param name="row">Row (counted from 1)</param>
+	/// <param name="function">Function receiving block</param>
+	template<typename Function>
+	void forEachRowBlock(int row, Function&& function) const
+	{
+		const std::uint64_t* summary = &m_summary[static_cast<size_t>(row) * m_summaryStride + 1];
+		for (int s = 0; s < m_summaryWords; ++s)
+		{
+			std::uint64_t word = summary[s];
+			while (word)
+			{
+				function(s * 64 + countTrailingZeros(word));
+				word &= word - 1;
+			}
+		}
+	}
+	/// <summary>
+	/// Mark block as possibly holding set bits
+	/// </summary>
+	/// <param name="row">Row (counted from 1)</param>
+	/// <param name="block">Block within row</param>
+	void setActive(int row, int block) { m_summary[static_cast<size_t>(row) * m_summaryStride + 1 + block / 64] |= std::uint64_t(1) << (block % 64); }
+	/// <summary>
+	/// Get index of first word of row
+	/// </summary>
+	/// <param name="row">Row (counted from 1)</param>
+	/// <returns>Index of word</returns>
+	size_t getRowOffset(int row) const { return static_cast<size_t>(row) * m_stride + BLOCK_WORDS; }
+	/// <summary>
+	/// Get index of word holding cell
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Index of word</returns>
+	size_t getWordIndex(int index) const { return getRowOffset(index / m_width + 1) + (index % m_width) / 64; }
+	/// <summary>
+	/// Get mask of cell within its word
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>Bit mask</returns>
+	std::uint64_t getBit(int index) const { return std::uint64_t(1) << ((index % m_width) & 63); }
+#ifdef __AVX2__
+	/// <summary>
+	/// Load 4 words from any address
+	/// </summary>
+	/// <param name="address">Address of first word</param>
+	/// <returns>Loaded words</returns>
+	static __m256i load(const std::uint64_t* address) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(address)); }
+#endif
+private:
+	int m_width{};							//!< Number of columns
+	int m_height{};							//!< Number of rows
+	int m_rowBlocks{};						//!< Number of blocks holding one row
+	int m_stride{};							//!< Distance between rows in words (row blocks + guard block)
+	std::vector<std::uint64_t> m_words;		//!< Bits of all rows with guard blocks and rows
+	int m_summaryWords{};					//!< Number of summary words of one row
+	int m_summaryStride{};					//!< Distance between summary rows in words (summary words + guard word)
+	std::vector<std::uint64_t> m_summary;	//!< One bit per block which may hold set bits, with guard words and rows
+};
\ No newline at end of file
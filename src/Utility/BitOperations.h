@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/// <summary>
+/// Get index of lowest set bit
+/// </summary>
+/// <param name="value">Non zero value</param>
+/// <returns>Bit index</returns>
+inline int countTrailingZeros(std::uint64_t value)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return static_cast<int>(index);
+#else
+	return __builtin_ctzll(value);
+#endif
+}
+
+/// <summary>
+/// Get number of set bits
+/// </summary>
+/// <param name="value">Value</param>
+/// <returns>Number of set bits</returns>
+inline int popCount(std::uint64_t value)
+{
+#ifdef _MSC_VER
+	return static_cast<int>(__popcnt64(value));
+#else
+	return __builtin_popcountll(value);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// Monotone priority queue for small integer keys (Dial's algorithm).
+/// Keys of all queued entries must lie in [lastPoppedKey, lastPoppedKey + maxStep], so entries are kept
+/// in a circular array of (maxStep + 1) buckets indexed by key modulo bucket count. All operations are O(1) amortized.
+/// </summary>
+class BucketQueue
+{
+public:
+	/// <summary>
+	/// Create bucket queue
+	/// </summary>
+	/// <param name="maxStep">Maximum difference between pushed key and last popped key</param>
+	explicit BucketQueue(int maxStep = 1) { setMaxStep(maxStep); }
+	/// <summary>
+	/// Change maximum key step (clears queue)
+	/// </summary>
+	/// <param name="maxStep">Maximum difference between pushed key and last popped key</param>
+	void setMaxStep(int maxStep)
+	{
+		m_buckets.assign(maxStep + 1, {});
+		clear();
+	}
+	/// <summary>
+	/// Remove all entries (keeps bucket memory)
+	/// </summary>
+	void clear()
+	{
+		for (auto& bucket : m_buckets)
+		{
+			bucket.clear();
+		}
+		m_size = 0;
+		m_currentBucket = 0;
+		m_currentKey = 0;
+	}
+	/// <summary>
+	/// Check if queue is empty
+	/// </summary>
+	/// <returns>True if queue is empty</returns>
+	bool empty() const { return m_size == 0; }
+	/// <summary>
+	/// Insert entry
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <param name="key">Priority (must not be lower than last popped key)</param>
+	void push(int index, int key)
+	{
+		m_buckets[key % m_buckets.size()].push_back(index);
+		m_size++;
+	}
+	/// <summary>
+	/// Remove entry with lowest key (queue must not be empty)
+	/// </summary>
+	/// <returns>Index and key of removed entry</returns>
+	std::pair<int, int> pop()
+	{
+		int bucketCount = static_cast<int>(m_buckets.size());
+		while (m_buckets[m_currentBucket].empty())
+		{
+			m_currentKey++;
+			if (++m_currentBucket == bucketCount)
+			{
+				m_currentBucket = 0;
+			}
+		}
+		std::vector<int>& bucket = m_buckets[m_currentBucket];
+		int index = bucket.back();
+		bucket.pop_back();
+		m_size--;
+		return { index, m_currentKey };
+	}
+private:
+	std::vector<std::vector<int>> m_buckets;	//!< Circular array of buckets
+	int m_size{};								//!< Number of entries
+	int m_currentBucket{};						//!< Bucket containing entries with current key
+	int m_currentKey{};							//!< Lowest key that can still be queued
+};
\ No newline at end of file
@@ -0,0 +1,336 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// Strategy used by IndexedHeap when an already queued index is pushed again
+/// </summary>
+enum class HeapMode
+{
+	DECREASE_KEY,		//!< Keep one entry per index and move it up when its key drops
+	LAZY_DELETION,		//!< Push duplicate entry and skip outdated ones when they reach the top
+};
+
+/// <summary>
+/// Operation counters of IndexedHeap
+/// </summary>
+struct HeapStats
+{
+	int pushes{};			//!< Number of inserted entries
+	int pops{};				//!< Number of removed valid entries
+	int decreaseKeys{};		//!< Number of in-place key decreases (DECREASE_KEY mode)
+	int stalePops{};		//!< Number of skipped outdated entries (LAZY_DELETION mode)
+};
+
+/// <summary>
+/// Min d-ary heap of cell indexes with position map, supporting decrease-key.
+/// Position map is tagged with epoch so clearing the heap does not touch it.
+/// </summary>
+/// <typeparam name="Key">Type of priority</typeparam>
+/// <typeparam name="Arity">Number of children of each node</typeparam>
+template<typename Key, int Arity = 4>
+class IndexedHeap
+{
+	/// <summary>
+	/// Heap entry
+	/// </summary>
+	struct Node
+	{
+		Key key;	//!< Priority
+		int index;	//!< Index of cell
+	};
+public:
+	/// <summary>
+	/// Create heap
+	/// </summary>
+	/// <param name="mode">Strategy for repeated pushes of the same index</param>
+	explicit IndexedHeap(HeapMode mode = HeapMode::DECREASE_KEY) : m_mode{ mode } {}
+	/// <summary>
+	/// Allocate position map for indexes [0,indexCount)
+	/// </summary>
+	/// <param name="indexCount">Number of indexes</param>
+	void resize(int indexCount)
+	{
+		m_positions.assign(indexCount, NOT_QUEUED);
+		m_stamps.assign(indexCount, 0);
+		m_keys.assign(indexCount, Key());
+		m_epoch = 1;
+		clear();
+	}
+	/// <summary>
+	/// Remove all entries and reset counters
+	/// </summary>
+	void clear()
+	{
+		m_nodes.clear();
+		m_stats = HeapStats();
+		if (++m_epoch == 0)
+		{
+			std::fill(m_stamps.begin(), m_stamps.end(), 0);
+			m_epoch = 1;
+		}
+	}
+	/// <summary>
+	/// Check if there are any valid entries left
+	/// </summary>
+	/// <returns>True if heap is empty</returns>
+	bool empty()
+	{
+		if (m_mode == HeapMode::LAZY_DELETION)
+		{
+			discardStale();
+		}
+		return m_nodes.empty();
+	}
+	/// <summary>
+	/// Insert index or lower its key (higher key of queued index is ignored)
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <param name="key">Priority of cell</param>
+	void push(int index, Key key)
+	{
+		if (isQueued(index))
+		{
+			if (m_mode == HeapMode::DECREASE_KEY)
+			{
+				int position = m_positions[index];
+				if (key < m_nodes[position].key)
+				{
+					m_nodes[position].key = key;
+					siftUp(position);
+					m_stats.decreaseKeys++;
+				}
+				return;
+			}
+			if (!(key < m_keys[index]))
+			{
+				return;
+			}
+		}
+		m_stamps[index] = m_epoch;
+		m_keys[index] = key;
+		m_positions[index] = static_cast<int>(m_nodes.size());
+		m_nodes.push_back({ key, index });
+		siftUp(static_cast<int>(m_nodes.size()) - 1);
+		m_stats.pushes++;
+	}
+	/// <summary>
+	/// Insert index or change its key in either direction (DECREASE_KEY mode only)
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <param name="key">Priority of cell</param>
+	void update(int index, Key key)
+	{
+		if (!isQueued(index))
+		{
+			push(index, key);
+			return;
+		}
+		int position = m_positions[index];
+		bool isDecreased = key < m_nodes[position].key;
+		m_nodes[position].key = key;
+		if (isDecreased)
+		{
+			siftUp(position);
+		}
+		else
+		{
+			siftDown(position);
+		}
+	}
+	/// <summary>
+	/// Remove index if it is queued (DECREASE_KEY mode only)
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	void remove(int index)
+	{
+		if (!isQueued(index))
+		{
+			return;
+		}
+		int position = m_positions[index];
+		m_positions[index] = POPPED;
+		Node last = m_nodes.back();
+		m_nodes.pop_back();
+		if (position < static_cast<int>(m_nodes.size()))
+		{
+			// Last entry fills the gap and may have to move either way
+			place(position, last);
+			siftUp(position);
+			if (m_positions[last.index] == position)
+			{
+				siftDown(position);
+			}
+		}
+	}
+	/// <summary>
+	/// Remove entry with lowest key (heap must not be empty)
+	/// </summary>
+	/// <returns>Index and key of removed entry</returns>
+	std::pair<int, Key> pop()
+	{
+		if (m_mode == HeapMode::LAZY_DELETION)
+		{
+			discardStale();
+		}
+		Node top = m_nodes.front();
+		removeTop();
+		m_positions[top.index] = POPPED;
+		m_stats.pops++;
+		return { top.index, top.key };
+	}
+	/// <summary>
+	/// Get entry with lowest key without removing it (heap must not be empty)
+	/// </summary>
+	/// <returns>Index and key of top entry</returns>
+	std::pair<int, Key> top()
+	{
+		if (m_mode == HeapMode::LAZY_DELETION)
+		{
+			discardStale();
+		}
+		return { m_nodes.front().index, m_nodes.front().key };
+	}
+	/// <summary>
+	/// Check if index is waiting in heap
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <returns>True if index is queued</returns>
+	bool isQueued(int index) const { return m_stamps[index] == m_epoch && m_positions[index] >= 0; }
+	/// <summary>
+	/// Get number of entries (including outdated ones in LAZY_DELETION mode)
+	/// </summary>
+	/// <returns>Number of entries</returns>
+	int size() const { return static_cast<int>(m_nodes.size()); }
+	/// <summary>
+	/// Get operation counters since last clear
+	/// </summary>
+	/// <returns>Heap statistics</returns>
+	const HeapStats& getStats() const { return m_stats; }
+	/// <summary>
+	/// Get heap mode
+	/// </summary>
+	/// <returns>Heap mode</returns>
+	HeapMode getMode() const { return m_mode; }
+	/// <summary>
+	/// Change heap mode (clears heap)
+	/// </summary>
+	/// <param name="mode">New heap mode</param>
+	void setMode(HeapMode mode)
+	{
+		m_mode = mode;
+		clear();
+	}
+private:
+	/// <summary>
+	/// Remove root entry and restore heap order
+	/// </summary>
+	void removeTop()
+	{
+		m_nodes.front() = m_nodes.back();
+		m_nodes.pop_back();
+		if (!m_nodes.empty())
+		{
+			siftDown(0);
+		}
+	}
+	/// <summary>
+	/// Drop outdated entries from top of heap (entries of indexes that were already popped and entries
+	/// superseded by newer push, which may follow pop of the same index)
+	/// </summary>
+	void discardStale()
+	{
+		while (!m_nodes.empty() && isStale(m_nodes.front()))
+		{
+			removeTop();
+			m_stats.stalePops++;
+		}
+	}
+	/// <summary>
+	/// Check if entry is outdated (LAZY_DELETION mode)
+	/// </summary>
+	/// <param name="node">Heap entry</param>
+	/// <returns>True if index was popped or entry does not hold key of latest push</returns>
+	bool isStale(const Node& node) const
+	{
+		const Key& latestKey = m_keys[node.index];
+		return m_positions[node.index] == POPPED || node.key < latestKey || latestKey < node.key;
+	}
+	/// <summary>
+	/// Move entry towards root until heap order is restored
+	/// </summary>
+	/// <param name="position">Position of entry</param>
+	void siftUp(int position)
+	{
+		Node node = m_nodes[position];
+		while (position > 0)
+		{
+			int parent = (position - 1) / Arity;
+			if (!(node.key < m_nodes[parent].key))
+			{
+				break;
+			}
+			place(position, m_nodes[parent]);
+			position = parent;
+		}
+		place(position, node);
+	}
+	/// <summary>
+	/// Move entry towards leaves until heap order is restored
+	/// </summary>
+	/// <param name="position">Position of entry</param>
+	void siftDown(int position)
+	{
+		Node node = m_nodes[position];
+		int nodeCount = static_cast<int>(m_nodes.size());
+		while (true)
+		{
+			int firstChild = position * Arity + 1;
+			if (firstChild >= nodeCount)
+			{
+				break;
+			}
+			int lastChild = std::min(firstChild + Arity, nodeCount);
+			int bestChild = firstChild;
+			for (int child = firstChild + 1; child < lastChild; ++child)
+			{
+				if (m_nodes[child].key < m_nodes[bestChild].key)
+				{
+					bestChild = child;
+				}
+			}
+			if (!(m_nodes[bestChild].key < node.key))
+			{
+				break;
+			}
+			place(position, m_nodes[bestChild]);
+			position = bestChild;
+		}
+		place(position, node);
+	}
+	/// <summary>
+	/// Store entry at position and update position map
+	/// </summary>
+	/// <param name="position">Position in heap</param>
+	/// <param name="node">Entry to store</param>
+	void place(int position, const Node& node)
+	{
+		m_nodes[position] = node;
+		if (m_mode == HeapMode::DECREASE_KEY)
+		{
+			m_positions[node.index] = position;
+		}
+	}
+private:
+	static constexpr int NOT_QUEUED = -1;		//!< Index was never pushed in current epoch
+	static constexpr int POPPED = -2;			//!< Index was already removed from heap
+	HeapMode m_mode;							//!< Strategy for repeated pushes
+	std::vector<Node> m_nodes;					//!< Heap entries
+	std::vector<int> m_positions;				//!< Position of each index in heap (valid only with current stamp)
+	std::vector<std::uint32_t> m_stamps;		//!< Epoch in which index was last pushed
+	std::vector<Key> m_keys;					//!< Key of latest push of each index (LAZY_DELETION mode)
+	std::uint32_t m_epoch{ 1 };					//!< Current epoch
+	HeapStats m_stats;							//!< Operation counters
+};
\ No newline at end of file
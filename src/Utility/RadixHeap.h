@@ -0,0 +1,97 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// Monotone radix heap for 32-bit unsigned keys.
+/// Entry is stored in bucket given by the highest bit in which its key differs from last popped key,
+/// so each entry moves between buckets at most 32 times. Works for any edge weight width.
+/// </summary>
+class RadixHeap
+{
+	using Entry = std::pair<std::uint32_t, int>;
+public:
+	/// <summary>
+	/// Remove all entries (keeps bucket memory)
+	/// </summary>
+	void clear()
+	{
+		for (auto& bucket : m_buckets)
+		{
+			bucket.clear();
+		}
+		m_size = 0;
+		m_lastKey = 0;
+	}
+	/// <summary>
+	/// Check if heap is empty
+	/// </summary>
+	/// <returns>True if heap is empty</returns>
+	bool empty() const { return m_size == 0; }
+	/// <summary>
+	/// Insert entry
+	/// </summary>
+	/// <param name="index">Index of cell</param>
+	/// <param name="key">Priority (must not be lower than last popped key)</param>
+	void push(int index, int key)
+	{
+		std::uint32_t unsignedKey = static_cast<std::uint32_t>(key);
+		m_buckets[getBucket(unsignedKey)].push_back({ unsignedKey, index });
+		m_size++;
+	}
+	/// <summary>
+	/// Remove entry with lowest key (heap must not be empty)
+	/// </summary>
+	/// <returns>Index and key of removed entry</returns>
+	std::pair<int, int> pop()
+	{
+		if (m_buckets[0].empty())
+		{
+			// Find first non empty bucket and redistribute it around its minimum key
+			int bucketIndex = 1;
+			while (m_buckets[bucketIndex].empty())
+			{
+				bucketIndex++;
+			}
+			std::vector<Entry>& bucket = m_buckets[bucketIndex];
+			std::uint32_t minKey = bucket.front().first;
+			for (const Entry& entry : bucket)
+			{
+				minKey = entry.first < minKey ? entry.first : minKey;
+			}
+			m_lastKey = minKey;
+			for (const Entry& entry : bucket)
+			{
+				m_buckets[getBucket(entry.first)].push_back(entry);
+			}
+			bucket.clear();
+		}
+		Entry entry = m_buckets[0].back();
+		m_buckets[0].pop_back();
+		m_size--;
+		return { entry.second, static_cast<int>(entry.first) };
+	}
+private:
+	/// <summary>
+	/// Get bucket of key relative to last popped key
+	/// </summary>
+	/// <param name="key">Key of entry</param>
+	/// <returns>Bucket index (number of significant bits of key ^ lastKey)</returns>
+	int getBucket(std::uint32_t key) const
+	{
+		std::uint32_t difference = key ^ m_lastKey;
+		int bits = 0;
+		while (difference)
+		{
+			difference >>= 1;
+			bits++;
+		}
+		return bits;
+	}
+private:
+	std::array<std::vector<Entry>, 33> m_buckets;	//!< Buckets of entries
+	int m_size{};									//!< Number of entries
+	std::uint32_t m_lastKey{};						//!< Last popped key
+};
\ No newline at end of file
@@ -0,0 +1,153 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+
+/// <summary>
+/// How SimulationClock decides number of steps run in frame
+/// </summary>
+enum class ClockMode
+{
+	FIXED_RATE,		//!< Steps follow wall time at fixed number of steps per second
+	TIME_BUDGET,	//!< As many steps as fit into fixed time per frame
+};
+
+/// <summary>
+/// Decides how many simulation steps are run in each frame, so speed of search does not depend on frame rate and grid size.
+/// In time budget mode number of steps is predicted from measured cost of earlier steps and grows at most twice per frame,
+/// so change of step cost (e.g. search turning into path reconstruction) does not stall a frame.
+/// In fixed rate mode steps owed for elapsed wall time are run, but never more than fit into time budget and never more than
+/// MAX_LAG_SECONDS of them, so rate which grid cannot keep up with slows simulation down instead of frame rate.
+/// </summary>
+class SimulationClock
+{
+public:
+	static constexpr double DEFAULT_STEPS_PER_SECOND = 1000.0;	//!< Default rate of fixed rate mode
+	static constexpr double DEFAULT_BUDGET_MICROSECONDS = 8000.0;	//!< Default time spent stepping per frame (also limits fixed rate mode)
+	static constexpr double SPEED_FACTOR = 2.0;						//!< Change of rate or budget per speed up or slow down
+	static constexpr double MAX_LAG_SECONDS = 0.1;					//!< Highest wall time caught up in one frame of fixed rate mode
+	/// <summary>
+	/// Create clock
+	/// </summary>
+	/// <param name="mode">Initial mode</param>
+	explicit SimulationClock(ClockMode mode = ClockMode::FIXED_RATE) : m_mode{ mode }
+	{
+		restart();
+	}
+	/// <summary>
+	/// Forget time elapsed so far (call when simulation is resumed after pause)
+	/// </summary>
+	void restart()
+	{
+		m_lastTime = std::chrono::high_resolution_clock::now();
+		m_pendingSteps = 0.0;
+	}
+	/// <summary>
+	/// Get number of steps to run in current frame, call once per frame
+	/// </summary>
+	/// <returns>Number of steps</returns>
+	int getStepCount()
+	{
+		auto now = std::chrono::high_resolution_clock::now();
+		double elapsed = std::min(std::chrono::duration<double>(now - m_lastTime).count(), MAX_LAG_SECONDS);
+		m_lastTime = now;
+		if (m_mode == ClockMode::FIXED_RATE)
+		{
+			m_pendingSteps = std::min(m_pendingSteps + elapsed * m_stepsPerSecond, std::max(1.0, MAX_LAG_SECONDS * m_stepsPerSecond));
+			int stepCount = std::min(static_cast<int>(m_pendingSteps), getAffordableStepCount());
+			m_pendingSteps -= stepCount;
+			return stepCount;
+		}
+		return getAffordableStepCount();
+	}
+	/// <summary>
+	/// Report time spent running steps of current frame (used by time budget mode)
+	/// </summary>
+	/// <param name="stepCount">Number of steps run</param>
+	/// <param name="seconds">Time spent running them</param>
+	void reportStepTime(int stepCount, double seconds)
+	{
+		if (stepCount <= 0)
+		{
+			return;
+		}
+		double stepMicroseconds = seconds * 1000000.0 / stepCount;
+		// Smooth out single slow frames
+		m_stepMicroseconds = m_stepMicroseconds == 0.0 ? stepMicroseconds : (m_stepMicroseconds + stepMicroseconds) / 2.0;
+		m_lastStepCount = stepCount;
+	}
+	/// <summary>
+	/// Raise steps per second or time budget
+	/// </summary>
+	void speedUp()
+	{
+		if (m_mode == ClockMode::FIXED_RATE)
+		{
+			m_stepsPerSecond = std::min(m_stepsPerSecond * SPEED_FACTOR, MAX_STEPS_PER_SECOND);
+		}
+		else
+		{
+			m_budgetMicroseconds = std::min(m_budgetMicroseconds * SPEED_FACTOR, MAX_BUDGET_MICROSECONDS);
+		}
+	}
+	/// <summary>
+	/// Lower steps per second or time budget
+	/// </summary>
+	void slowDown()
+	{
+		if (m_mode == ClockMode::FIXED_RATE)
+		{
+			m_stepsPerSecond = std::max(m_stepsPerSecond / SPEED_FACTOR, MIN_STEPS_PER_SECOND);
+		}
+		else
+		{
+			m_budgetMicroseconds = std::max(m_budgetMicroseconds / SPEED_FACTOR, MIN_BUDGET_MICROSECONDS);
+		}
+	}
+	/// <summary>
+	/// Switch between fixed rate and time budget mode
+	/// </summary>
+	void switchMode()
+	{
+		m_mode = m_mode == ClockMode::FIXED_RATE ? ClockMode::TIME_BUDGET : ClockMode::FIXED_RATE;
+		restart();
+	}
+	/// <summary>
+	/// Get current mode
+	/// </summary>
+	/// <returns>Clock mode</returns>
+	ClockMode getMode() const { return m_mode; }
+	/// <summary>
+	/// Get rate of fixed rate mode
+	/// </summary>
+	/// <returns>Steps per second</returns>
+	double getStepsPerSecond() const { return m_stepsPerSecond; }
+	/// <summary>
+	/// Get budget of time budget mode
+	/// </summary>
+	/// <returns>Time spent stepping per frame in microseconds</returns>
+	double getBudgetMicroseconds() const { return m_budgetMicroseconds; }
+private:
+	/// <summary>
+	/// Predict number of steps which fit into time budget
+	/// </summary>
+	/// <returns>Number of steps (at least one)</returns>
+	int getAffordableStepCount() const
+	{
+		double stepCount = m_budgetMicroseconds / std::max(m_stepMicroseconds, MIN_STEP_MICROSECONDS);
+		return std::max(1, static_cast<int>(std::min(stepCount, 2.0 * m_lastStepCount)));
+	}
+private:
+	static constexpr double MIN_STEPS_PER_SECOND = 1.0;				//!< Lowest rate of fixed rate mode
+	static constexpr double MAX_STEPS_PER_SECOND = 1.0e9;			//!< Highest rate of fixed rate mode
+	static constexpr double MIN_BUDGET_MICROSECONDS = 125.0;		//!< Lowest budget of time budget mode
+	static constexpr double MAX_BUDGET_MICROSECONDS = 256000.0;		//!< Highest budget of time budget mode
+	static constexpr double MIN_STEP_MICROSECONDS = 0.001;			//!< Lower bound of measured step cost, so empty steps do not predict huge counts
+private:
+	ClockMode m_mode;												//!< Current mode
+	double m_stepsPerSecond{ DEFAULT_STEPS_PER_SECOND };			//!< Rate of fixed rate mode
+	double m_budgetMicroseconds{ DEFAULT_BUDGET_MICROSECONDS };		//!< Time spent stepping per frame
+	double m_pendingSteps{};										//!< Fraction of step owed from earlier frames in fixed rate mode
+	double m_stepMicroseconds{};									//!< Smoothed cost of one step
+	int m_lastStepCount{ 1 };										//!< Number of steps run in last reported frame
+	std::chrono::high_resolution_clock::time_point m_lastTime;		//!< Time of last getStepCount or restart
+};
\ No newline at end of file
@@ -0,0 +1,254 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// Wall time of task finished by TaskScheduler
+/// </summary>
+struct TaskTiming
+{
+	int id;					//!< Identifier given when task was submitted
+	int threadIndex;		//!< Thread which ran the task (0 is thread calling wait)
+	float microseconds;		//!< Time spent running the task
+};
+
+/// <summary>
+/// Work-stealing pool running independent tasks of different length.
+/// Every thread owns a deque of tasks: it takes its own newest task from the back and, when its deque is empty,
+/// steals oldest task from the front of other deques, so threads finishing short tasks take over work of busy ones.
+/// Tasks submitted from outside are dealt round-robin, tasks submitted by running task stay on deque of its thread.
+/// Calling thread takes part in wait() as thread 0, so scheduler of size 1 spawns no threads.
+/// </summary>
+class TaskScheduler
+{
+	/// <summary>
+	/// Queued task
+	/// </summary>
+	struct Task
+	{
+		std::function<void()> function;		//!< Work of task
+		int id;								//!< Identifier reported in timings
+	};
+	/// <summary>
+	/// Tasks and timings owned by one thread
+	/// </summary>
+	struct Worker
+	{
+		std::mutex mutex;					//!< Guards tasks (timings are only touched by owner and by wait after all tasks finished)
+		std::deque<Task> tasks;				//!< Tasks waiting to run
+		std::vector<TaskTiming> timings;	//!< Tasks finished by thread since last wait
+	};
+public:
+	/// <summary>
+	/// Create scheduler
+	/// </summary>
+	/// <param name="threadCount">Number of threads running tasks (including thread calling wait)</param>
+	explicit TaskScheduler(int threadCount) : m_threadCount{ std::max(1, threadCount) }
+	{
+		for (int i = 0; i < m_threadCount; ++i)
+		{
+			m_workers.push_back(std::make_unique<Worker>());
+		}
+		for (int i = 1; i < m_threadCount; ++i)
+		{
+			m_threads.emplace_back(&TaskScheduler::workerLoop, this, i);
+		}
+	}
+	/// <summary>
+	/// Stop and join workers (tasks not waited for are dropped)
+	/// </summary>
+	~TaskScheduler()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_isStopping = true;
+		}
+		m_workCondition.notify_all();
+		for (auto& thread : m_threads)
+		{
+			thread.join();
+		}
+	}
+	TaskScheduler(const TaskScheduler&) = delete;
+	TaskScheduler& operator=(const TaskScheduler&) = delete;
+	/// <summary>
+	/// Get number of threads running tasks
+	/// </summary>
+	/// <returns>Thread count</returns>
+	int getThreadCount() const { return m_threadCount; }
+	/// <summary>
+	/// Queue task, workers may start it right away.
+	/// Outside of tasks, only thread calling wait may submit.
+	/// </summary>
+	/// <param name="id">Identifier reported in timings</param>
+	/// <param name="task">Work of task</param>
+	void submit(int id, std::function<void()> task)
+	{
+		int threadIndex = t_scheduler == this ? t_threadIndex : m_nextWorker++ % m_threadCount;
+		m_pendingTasks.fetch_add(1);
+		m_queuedTasks.fetch_add(1);
+		{
+			Worker& worker = *m_workers[threadIndex];
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			worker.tasks.push_back(Task{ std::move(task), id });
+		}
+		{
+			// Worker checking for work under mutex either sees new task or is already waiting for notification
+			std::lock_guard<std::mutex> lock(m_mutex);
+		}
+		m_workCondition.notify_one();
+	}
+	/// <summary>
+	/// Run tasks on calling thread until every submitted task finished, then collect timings.
+	/// Rethrows first exception thrown by a task.
+	/// </summary>
+	void wait()
+	{
+		const TaskScheduler* outerScheduler = t_scheduler;
+		int outerThreadIndex = t_threadIndex;
+		t_scheduler = this;
+		t_threadIndex = 0;
+		while (m_pendingTasks.load() > 0)
+		{
+			if (!runTask(0))
+			{
+				// Remaining tasks are running on workers, which also pick up any task they submit
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_doneCondition.wait(lock, [this] { return m_pendingTasks.load() == 0; });
+			}
+		}
+		t_scheduler = outerScheduler;
+		t_threadIndex = outerThreadIndex;
+		m_timings.clear();
+		for (auto& worker : m_workers)
+		{
+			m_timings.insert(m_timings.end(), worker->timings.begin(), worker->timings.end());
+			worker->timings.clear();
+		}
+		std::stable_sort(m_timings.begin(), m_timings.end(), [](const TaskTiming& a, const TaskTiming& b) { return a.id < b.id; });
+		if (m_exception)
+		{
+			std::exception_ptr exception = m_exception;
+			m_exception = nullptr;
+			std::rethrow_exception(exception);
+		}
+	}
+	/// <summary>
+	/// Get timings of tasks finished before last wait
+	/// </summary>
+	/// <returns>Timings ordered by task identifier</returns>
+	const std::vector<TaskTiming>& getTimings() const { return m_timings; }
+private:
+	/// <summary>
+	/// Take newest own task or steal oldest task of other thread and run it
+	/// </summary>
+	/// <param name="threadIndex">Index of running thread</param>
+	/// <returns>False if every deque was empty</returns>
+	bool runTask(int threadIndex)
+	{
+		Task task;
+		if (!popTask(threadIndex, task))
+		{
+			return false;
+		}
+		auto begin = std::chrono::high_resolution_clock::now();
+		try
+		{
+			task.function();
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_exception)
+			{
+				m_exception = std::current_exception();
+			}
+		}
+		std::chrono::duration<float, std::micro> duration = std::chrono::high_resolution_clock::now() - begin;
+		m_workers[threadIndex]->timings.push_back(TaskTiming{ task.id, threadIndex, duration.count() });
+		if (m_pendingTasks.fetch_sub(1) == 1)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_doneCondition.notify_all();
+		}
+		return true;
+	}
+	/// <summary>
+	/// Take task from own deque or steal from other one
+	/// </summary>
+	/// <param name="threadIndex">Index of running thread</param>
+	/// <param name="task">Taken task</param>
+	/// <returns>False if every deque was empty</returns>
+	bool popTask(int threadIndex, Task& task)
+	{
+		for (int i = 0; i < m_threadCount; ++i)
+		{
+			int victim = (threadIndex + i) % m_threadCount;
+			Worker& worker = *m_workers[victim];
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			if (worker.tasks.empty())
+			{
+				continue;
+			}
+			if (victim == threadIndex)
+			{
+				task = std::move(worker.tasks.back());
+				worker.tasks.pop_back();
+			}
+			else
+			{
+				task = std::move(worker.tasks.front());
+				worker.tasks.pop_front();
+			}
+			m_queuedTasks.fetch_sub(1);
+			return true;
+		}
+		return false;
+	}
+	/// <summary>
+	/// Run tasks, sleeping while no task is queued, until scheduler is destroyed
+	/// </summary>
+	/// <param name="threadIndex">Index of worker thread</param>
+	void workerLoop(int threadIndex)
+	{
+		t_scheduler = this;
+		t_threadIndex = threadIndex;
+		while (true)
+		{
+			if (runTask(threadIndex))
+			{
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_workCondition.wait(lock, [this] { return m_isStopping || m_queuedTasks.load() > 0; });
+			if (m_isStopping)
+			{
+				return;
+			}
+		}
+	}
+private:
+	static inline thread_local const TaskScheduler* t_scheduler{ nullptr };	//!< Scheduler whose task runs on this thread
+	static inline thread_local int t_threadIndex{};							//!< Index of this thread in that scheduler
+	int m_threadCount;										//!< Number of threads running tasks
+	std::vector<std::unique_ptr<Worker>> m_workers;			//!< Deques of threads, indexed by thread
+	std::vector<std::thread> m_threads;						//!< Worker threads (calling thread is not included)
+	std::mutex m_mutex;										//!< Guards sleeping and first exception
+	std::condition_variable m_workCondition;				//!< Signals queued task or stop request
+	std::condition_variable m_doneCondition;				//!< Signals that every task finished
+	std::atomic<int> m_pendingTasks{ 0 };					//!< Tasks submitted and not finished
+	std::atomic<int> m_queuedTasks{ 0 };					//!< Tasks waiting in deques
+	unsigned m_nextWorker{};								//!< Deque receiving next task submitted from outside
+	std::exception_ptr m_exception;							//!< First exception thrown by task since last wait
+	std::vector<TaskTiming> m_timings;						//!< Timings collected by last wait
+	bool m_isStopping{ false };								//!< Scheduler is being destroyed
+};
\ No newline at end of file
@@ -0,0 +1,136 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// Fixed set of worker threads running the same job in lockstep (fork-join).
+/// Calling thread takes part in every job as thread 0, so pool of size 1 spawns no threads.
+/// </summary>
+class ThreadPool
+{
+public:
+	/// <summary>
+	/// Create pool
+	/// </summary>
+	/// <param name="threadCount">Number of threads taking part in jobs (including calling thread)</param>
+	explicit ThreadPool(int threadCount) : m_threadCount{ std::max(1, threadCount) }
+	{
+		for (int i = 1; i < m_threadCount; ++i)
+		{
+			m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+		}
+	}
+	/// <summary>
+	/// Stop and join workers
+	/// </summary>
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_isStopping = true;
+		}
+		m_jobCondition.notify_all();
+		for (auto& worker : m_workers)
+		{
+			worker.join();
+		}
+	}
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	/// <summary>
+	/// Get number of threads taking part in jobs
+	/// </summary>
+	/// <returns>Thread count</returns>
+	int getThreadCount() const { return m_threadCount; }
+	/// <summary>
+	/// Run job on all threads and wait until every thread finishes it
+	/// </summary>
+	/// <param name="job">Job receiving index of thread [0, threadCount)</param>
+	void run(const std::function<void(int)>& job)
+	{
+		if (m_threadCount == 1)
+		{
+			job(0);
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_job = &job;
+			m_pendingWorkers = m_threadCount - 1;
+			m_generation++;
+		}
+		m_jobCondition.notify_all();
+		job(0);
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_doneCondition.wait(lock, [this] { return m_pendingWorkers == 0; });
+		m_job = nullptr;
+	}
+	/// <summary>
+	/// Split range [0, count) into chunks handed out dynamically to all threads and wait until whole range is processed
+	/// </summary>
+	/// <param name="count">Number of items</param>
+	/// <param name="chunkSize">Number of items taken at once</param>
+	/// <param name="body">Function processing items [begin, end) on given thread</param>
+	void parallelFor(int count, int chunkSize, const std::function<void(int, int, int)>& body)
+	{
+		std::atomic<int> nextItem{ 0 };
+		run([&](int threadIndex)
+			{
+				while (true)
+				{
+					int begin = nextItem.fetch_add(chunkSize, std::memory_order_relaxed);
+					if (begin >= count)
+					{
+						break;
+					}
+					body(threadIndex, begin, std::min(begin + chunkSize, count));
+				}
+			});
+	}
+private:
+	/// <summary>
+	/// Wait for jobs and run them until pool is destroyed
+	/// </summary>
+	/// <param name="threadIndex">Index of worker thread</param>
+	void workerLoop(int threadIndex)
+	{
+		unsigned lastGeneration = 0;
+		while (true)
+		{
+			const std::function<void(int)>* job;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_jobCondition.wait(lock, [&] { return m_isStopping || m_generation != lastGeneration; });
+				if (m_isStopping)
+				{
+					return;
+				}
+				lastGeneration = m_generation;
+				job = m_job;
+			}
+			(*job)(threadIndex);
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (--m_pendingWorkers == 0)
+				{
+					m_doneCondition.notify_one();
+				}
+			}
+		}
+	}
+private:
+	int m_threadCount;									//!< Number of threads taking part in jobs
+	std::vector<std::thread> m_workers;					//!< Worker threads (calling thread is not included)
+	std::mutex m_mutex;									//!< Guards job state
+	std::condition_variable m_jobCondition;				//!< Signals new job or stop request
+	std::condition_variable m_doneCondition;			//!< Signals that all workers finished job
+	const std::function<void(int)>* m_job{ nullptr };	//!< Current job
+	unsigned m_generation{};							//!< Number of started jobs
+	int m_pendingWorkers{};								//!< Workers still running current job
+	bool m_isStopping{ false };							//!< Pool is being destroyed
+};
\ No newline at end of file
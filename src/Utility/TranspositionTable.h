@@ -0,0 +1,206 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// Operation counters of TranspositionTable
+/// </summary>
+struct TableStats
+{
+	int stores{};			//!< Number of entries written to table
+	int evictions{};		//!< Number of entries replaced by entries of other cells
+	int rejections{};		//!< Number of stores refused because every entry of table was pinned
+	int peakEntries{};		//!< Largest number of live entries
+};
+
+/// <summary>
+/// Hash table of cell indexes with fixed memory budget given in megabytes, allocated once and never grown.
+/// Every bucket holds Ways entries. When bucket of new cell is full, entry with highest victim score is replaced,
+/// entries with negative score are pinned and cannot be replaced. If whole bucket is pinned, following buckets are probed,
+/// so table of pinned entries fills up completely. Entries are never removed one by one, only cleared all at once by epoch (O(1)),
+/// so probing can stop at first bucket with free entry. Slots of entries do not move, so they can be used as links between entries.
+/// </summary>
+/// <typeparam name="Value">Data stored for every cell</typeparam>
+/// <typeparam name="Ways">Number of entries in bucket</typeparam>
+template<typename Value, int Ways = 4>
+class TranspositionTable
+{
+	struct Entry
+	{
+		int key;				//!< Index of cell
+		std::uint32_t stamp;	//!< Epoch in which entry was written
+		Value value;			//!< Data of cell
+	};
+public:
+	static constexpr int NO_SLOT = -1;	//!< Slot returned when cell is not in table
+	/// <summary>
+	/// Allocate largest power of two number of buckets which fits into budget (clears table)
+	/// </summary>
+	/// <param name="megabytes">Memory budget (at least one bucket is always allocated)</param>
+	void resize(std::size_t megabytes)
+	{
+		std::size_t budget = megabytes << 20;
+		std::size_t bucketCount = 1;
+		while (bucketCount * 2 * Ways * sizeof(Entry) <= budget)
+		{
+			bucketCount *= 2;
+		}
+		m_entries.assign(bucketCount * Ways, Entry{ 0, 0, Value() });
+		m_bucketMask = static_cast<std::uint32_t>(bucketCount - 1);
+		m_epoch = 0;
+		clear();
+	}
+	/// <summary>
+	/// Remove all entries and reset counters (keeps memory)
+	/// </summary>
+	void clear()
+	{
+		if (++m_epoch == 0)
+		{
+			// Epoch wrapped around, stamps from previous cycle could match again
+			for (auto& entry : m_entries)
+			{
+				entry.stamp = 0;
+			}
+			m_epoch = 1;
+		}
+		m_size = 0;
+		m_stats = TableStats();
+	}
+	/// <summary>
+	/// Find entry of cell
+	/// </summary>
+	/// <param name="key">Index of cell</param>
+	/// <returns>Slot of entry or NO_SLOT</returns>
+	int find(int key) const
+	{
+		std::size_t bucket = getBucket(key);
+		for (std::size_t probe = 0; probe <= m_bucketMask; ++probe)
+		{
+			bool isFull = true;
+			std::size_t first = bucket * Ways;
+			for (std::size_t slot = first; slot < first + Ways; ++slot)
+			{
+				if (m_entries[slot].stamp != m_epoch)
+				{
+					isFull = false;
+				}
+				else if (m_entries[slot].key == key)
+				{
+					return static_cast<int>(slot);
+				}
+			}
+			// Cell would have been stored in this bucket if it had free entry
+			if (!isFull)
+			{
+				break;
+			}
+			bucket = (bucket + 1) & m_bucketMask;
+		}
+		return NO_SLOT;
+	}
+	/// <summary>
+	/// Create entry of cell which is not in table, using free entry or replacing entry with highest victim score
+	/// </summary>
+	/// <typeparam name="Score">Callable returning victim score of value (negative pins entry)</typeparam>
+	/// <param name="key">Index of cell</param>
+	/// <param name="victimScore">Victim score of stored values</param>
+	/// <returns>Slot of new entry (value is default constructed) or NO_SLOT if every entry is pinned</returns>
+	template<typename Score>
+	int insert(int key, Score victimScore)
+	{
+		std::size_t bucket = getBucket(key);
+		for (std::size_t probe = 0; probe <= m_bucketMask; ++probe)
+		{
+			std::size_t first = bucket * Ways;
+			int victim = NO_SLOT;
+			int victimValue = -1;
+			for (std::size_t slot = first; slot < first + Ways; ++slot)
+			{
+				if (m_entries[slot].stamp != m_epoch)
+				{
+					m_size++;
+					m_stats.peakEntries = std::max(m_stats.peakEntries, m_size);
+					return store(static_cast<int>(slot), key);
+				}
+				int score = victimScore(m_entries[slot].value);
+				if (score > victimValue)
+				{
+					victim = static_cast<int>(slot);
+					victimValue = score;
+				}
+			}
+			if (victim != NO_SLOT)
+			{
+				m_stats.evictions++;
+				return store(victim, key);
+			}
+			bucket = (bucket + 1) & m_bucketMask;
+		}
+		m_stats.rejections++;
+		return NO_SLOT;
+	}
+	/// <summary>
+	/// Get index of cell stored in slot
+	/// </summary>
+	/// <param name="slot">Slot of entry</param>
+	/// <returns>Index of cell</returns>
+	int getKey(int slot) const { return m_entries[slot].key; }
+	/// <summary>
+	/// Get data stored in slot
+	/// </summary>
+	/// <param name="slot">Slot of entry</param>
+	/// <returns>Data of cell</returns>
+	Value& getValue(int slot) { return m_entries[slot].value; }
+	/// <summary>
+	/// Get number of live entries
+	/// </summary>
+	/// <returns>Number of entries</returns>
+	int size() const { return m_size; }
+	/// <summary>
+	/// Get number of entries which fit into table
+	/// </summary>
+	/// <returns>Number of slots</returns>
+	int getCapacity() const { return static_cast<int>(m_entries.size()); }
+	/// <summary>
+	/// Get memory used by entries
+	/// </summary>
+	/// <returns>Size in bytes</returns>
+	std::size_t getMemoryUsage() const { return m_entries.size() * sizeof(Entry); }
+	/// <summary>
+	/// Get operation counters since last clear
+	/// </summary>
+	/// <returns>Table statistics</returns>
+	const TableStats& getStats() const { return m_stats; }
+private:
+	/// <summary>
+	/// Write new entry of cell to slot
+	/// </summary>
+	/// <param name="slot">Slot of entry</param>
+	/// <param name="key">Index of cell</param>
+	/// <returns>Slot of entry</returns>
+	int store(int slot, int key)
+	{
+		m_stats.stores++;
+		m_entries[slot] = Entry{ key, m_epoch, Value() };
+		return slot;
+	}
+	/// <summary>
+	/// Get bucket of cell (multiplicative hash, so neighbouring cells land in different buckets)
+	/// </summary>
+	/// <param name="key">Index of cell</param>
+	/// <returns>Bucket number</returns>
+	std::size_t getBucket(int key) const
+	{
+		std::uint32_t hash = static_cast<std::uint32_t>(key) * 0x9E3779B1u;
+		return (hash ^ hash >> 16) & m_bucketMask;
+	}
+private:
+	std::vector<Entry> m_entries;		//!< Buckets of entries, stored one after another
+	std::uint32_t m_bucketMask{};		//!< Number of buckets minus one
+	std::uint32_t m_epoch{};			//!< Stamp of live entries
+	int m_size{};						//!< Number of live entries
+	TableStats m_stats;					//!< Operation counters since last clear
+};
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/// <summary>
+/// Lock-free hand-over of values from one writer thread to one reader thread.
+/// Writer fills its own buffer and publishes it by swapping it with middle buffer, reader takes middle buffer only if it holds a newer value.
+/// Neither side ever waits for the other: writer can publish faster than reader reads (older unread values are dropped),
+/// and reader keeps its last value for as long as it needs it.
+/// Buffers are reused, so writer should update only what changed since the buffer was filled last time (two publishes ago).
+/// </summary>
+/// <typeparam name="T">Type of value</typeparam>
+template<typename T>
+class TripleBuffer
+{
+public:
+	/// <summary>
+	/// Get buffer owned by writer
+	/// </summary>
+	/// <returns>Buffer to fill before publish</returns>
+	T& getWriteBuffer() { return m_buffers[m_writeIndex]; }
+	/// <summary>
+	/// Hand filled write buffer to reader and take over another buffer for writing
+	/// </summary>
+	void publish()
+	{
+		m_writeIndex = m_middle.exchange(static_cast<std::uint8_t>(m_writeIndex | FRESH_FLAG), std::memory_order_acq_rel) & INDEX_MASK;
+	}
+	/// <summary>
+	/// Take latest published value if reader has not seen it yet
+	/// </summary>
+	/// <returns>True if read buffer changed</returns>
+	bool acquire()
+	{
+		if (!(m_middle.load(std::memory_order_relaxed) & FRESH_FLAG))
+		{
+			return false;
+		}
+		m_readIndex = m_middle.exchange(m_readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+		return true;
+	}
+	/// <summary>
+	/// Get buffer owned by reader
+	/// </summary>
+	/// <returns>Latest acquired value</returns>
+	const T& getReadBuffer() const { return m_buffers[m_readIndex]; }
+private:
+	static constexpr std::uint8_t INDEX_MASK = 3;	//!< Bits of middle holding index of buffer
+	static constexpr std::uint8_t FRESH_FLAG = 4;	//!< Bit of middle set when it holds value not yet acquired
+private:
+	T m_buffers[3];									//!< Write, middle and read buffers
+	alignas(64) std::atomic<std::uint8_t> m_middle{ 1 };	//!< Index of middle buffer and fresh flag
+	alignas(64) std::uint8_t m_writeIndex{ 0 };		//!< Index of buffer owned by writer
+	alignas(64) std::uint8_t m_readIndex{ 2 };		//!< Index of buffer owned by reader
+};
\ No newline at end of file